@@ -198,9 +198,13 @@ enum class Algo {
   kStdSort,
   kStdSelect,
   kStdPartialSort,
+  kStdStableSort,
   kVQSort,
   kVQPartialSort,
   kVQSelect,
+  kParallelVQSort,
+  kVQStableSort,
+  kVQRadixSort,
   kHeapSort,
   kHeapPartialSort,
   kHeapSelect,
@@ -211,6 +215,22 @@ static inline bool IsVQ(Algo algo) {
     case Algo::kVQSort:
     case Algo::kVQPartialSort:
     case Algo::kVQSelect:
+    case Algo::kParallelVQSort:
+    case Algo::kVQStableSort:
+    case Algo::kVQRadixSort:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether a single call uses multiple threads.
+static inline bool IsParallel(Algo algo) {
+  switch (algo) {
+#if HAVE_PARALLEL_IPS4O
+    case Algo::kParallelIPS4O:
+#endif
+    case Algo::kParallelVQSort:
       return true;
     default:
       return false;
@@ -284,12 +304,20 @@ static inline const char* AlgoName(Algo algo) {
       return "std_partial";
     case Algo::kStdSelect:
       return "std_select";
+    case Algo::kStdStableSort:
+      return "std_stable";
     case Algo::kVQSort:
       return "vq";
     case Algo::kVQPartialSort:
       return "vq_partial";
     case Algo::kVQSelect:
       return "vq_select";
+    case Algo::kParallelVQSort:
+      return "par_vq";
+    case Algo::kVQStableSort:
+      return "vq_stable";
+    case Algo::kVQRadixSort:
+      return "vq_radix";
     case Algo::kHeapSort:
       return "heap";
     case Algo::kHeapPartialSort:
@@ -458,6 +486,9 @@ InputStats<T> GenerateInput(const Dist dist, T* v, size_t num_lanes) {
 }
 
 struct SharedState {
+  // Required for Algo::kParallelVQSort; owned by the caller.
+  hwy::ThreadPool* thread_pool = nullptr;
+
 #if HAVE_PARALLEL_IPS4O
   const unsigned max_threads = hwy::LimitsMax<unsigned>();  // 16 for Table 1a
   ips4o::StdThreadPool pool{static_cast<int>(
@@ -465,6 +496,18 @@ struct SharedState {
 #endif
 };
 
+// VQRadixSort only supports 16 and 32-bit keys.
+template <typename KeyType, class Order,
+          HWY_IF_T_SIZE_ONE_OF(KeyType, (1 << 2) | (1 << 4))>
+void CallRadixSort(KeyType* keys, const size_t num_keys, Order) {
+  return VQRadixSort(keys, num_keys, Order());
+}
+template <typename KeyType, class Order,
+          HWY_IF_T_SIZE_ONE_OF(KeyType, (1 << 8) | (1 << 16))>
+void CallRadixSort(KeyType*, const size_t, Order) {
+  HWY_ABORT("VQRadixSort does not support %zu-byte keys", sizeof(KeyType));
+}
+
 // Adapters from Run's num_keys to vqsort-inl.h num_lanes.
 template <typename KeyType, class Order>
 void CallHeapSort(KeyType* keys, const size_t num_keys, Order) {
@@ -499,10 +542,6 @@ void Run(Algo algo, KeyType* inout, size_t num_keys, SharedState& shared,
 
   constexpr bool kAscending = Order::IsAscending();
 
-#if !HAVE_PARALLEL_IPS4O
-  (void)shared;
-#endif
-
   switch (algo) {
 #if HAVE_INTEL && HWY_TARGET <= HWY_AVX3
     case Algo::kIntel:
@@ -592,6 +631,12 @@ void Run(Algo algo, KeyType* inout, size_t num_keys, SharedState& shared,
         return std::nth_element(inout, inout + k_keys, inout + num_keys,
                                 greater);
       }
+    case Algo::kStdStableSort:
+      if (kAscending) {
+        return std::stable_sort(inout, inout + num_keys, less);
+      } else {
+        return std::stable_sort(inout, inout + num_keys, greater);
+      }
 
     case Algo::kVQSort:
       return VQSort(inout, num_keys, Order());
@@ -599,6 +644,13 @@ void Run(Algo algo, KeyType* inout, size_t num_keys, SharedState& shared,
       return VQPartialSort(inout, num_keys, k_keys, Order());
     case Algo::kVQSelect:
       return VQSelect(inout, num_keys, k_keys, Order());
+    case Algo::kParallelVQSort:
+      HWY_ASSERT(shared.thread_pool != nullptr);
+      return VQSort(inout, num_keys, Order(), *shared.thread_pool);
+    case Algo::kVQStableSort:
+      return VQStableSort(inout, num_keys, Order());
+    case Algo::kVQRadixSort:
+      return CallRadixSort(inout, num_keys, Order());
 
     case Algo::kHeapSort:
       return CallHeapSort(inout, num_keys, Order());
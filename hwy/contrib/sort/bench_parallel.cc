@@ -14,9 +14,8 @@
 // limitations under the License.
 
 // Concurrent, independent sorts for generating more memory traffic and testing
-// scalability when bandwidth-limited. If you want to use multiple threads for
-// a single sort, you can use ips4o and integrate vqsort by calling it from
-// `baseCaseSort` and increasing `IPS4OML_BASE_CASE_SIZE` to say 8192.
+// scalability when bandwidth-limited. Also measures the scalability of a single
+// sort using multiple threads via the VQSort overload that takes a ThreadPool.
 
 #include <stdint.h>
 #include <stdio.h>
@@ -27,6 +26,7 @@
 #include <thread>  //NOLINT
 #include <vector>
 
+#include "hwy/contrib/thread_pool/thread_pool.h"
 #include "hwy/timer.h"
 
 // clang-format off
@@ -223,6 +223,49 @@ void BenchParallel() {
   }
 }
 
+// Single sort of num_keys, using an increasing number of threads.
+void BenchParallelSort() {
+  // Not interested in benchmark results for other targets on x86
+  if (HWY_ARCH_X86 &&
+      (HWY_TARGET != HWY_AVX2 && HWY_TARGET != HWY_AVX3 &&
+       HWY_TARGET != HWY_AVX3_ZEN4 && HWY_TARGET != HWY_AVX3_SPR)) {
+    return;
+  }
+  if (!HaveThreadingSupport()) return;
+
+  const size_t NT = HWY_MAX(1, std::thread::hardware_concurrency());
+
+  detail::SharedTraits<detail::TraitsLane<detail::OrderAscending<int64_t>>> st;
+  using LaneType = typename decltype(st)::LaneType;
+  using KeyType = typename decltype(st)::KeyType;
+  using Order = typename decltype(st)::Order;
+  const size_t num_keys = size_t{100} * 1000 * 1000;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto aligned = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(aligned);
+
+  const Algo algo = Algo::kParallelVQSort;
+  const Dist dist = Dist::kUniform32;
+
+  std::vector<SortResult> results;
+  for (size_t nt = 1; nt <= NT; nt += HWY_MAX(1, NT / 16)) {
+    // The main thread also participates, hence one fewer worker thread.
+    hwy::ThreadPool pool(nt - 1);
+    SharedState shared;
+    shared.thread_pool = &pool;
+
+    (void)GenerateInput(dist, aligned.get(), num_lanes);
+    const Timestamp t0;
+    Run(algo, reinterpret_cast<KeyType*>(aligned.get()), num_keys, shared,
+        /*thread=*/0, /*k_keys=*/0, Order());
+    const double sec = SecondsSince(t0);
+    HWY_ASSERT(aligned[0] < aligned[num_lanes - 1]);
+    results.emplace_back(algo, dist, num_keys, nt, sec, sizeof(KeyType),
+                         st.KeyString());
+    results.back().Print();
+  }
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -235,6 +278,7 @@ namespace hwy {
 namespace {
 HWY_BEFORE_TEST(BenchParallel);
 HWY_EXPORT_AND_TEST_P(BenchParallel, BenchParallel);
+HWY_EXPORT_AND_TEST_P(BenchParallel, BenchParallelSort);
 HWY_AFTER_TEST();
 }  // namespace
 }  // namespace hwy
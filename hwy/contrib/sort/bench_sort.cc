@@ -16,6 +16,11 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <algorithm>  // std::merge
+#include <functional>  // std::less
+#include <queue>
+#include <string>
+#include <utility>  // std::pair
 #include <vector>
 
 // clang-format off
@@ -59,6 +64,7 @@ extern int64_t first_cold_target;  // for BenchAllColdSort
 namespace HWY_NAMESPACE {
 namespace {
 using detail::OrderAscending;
+using detail::OrderAscendingKV64;
 using detail::OrderDescending;
 using detail::SharedTraits;
 using detail::TraitsLane;
@@ -450,6 +456,342 @@ HWY_NOINLINE void BenchAllSort() {
   }
 }
 
+// Compares VQStableSort with std::stable_sort for all distributions.
+template <class Traits>
+HWY_NOINLINE void BenchStableSort(size_t num_keys) {
+  SharedState shared;
+  detail::SharedTraits<Traits> st;
+  using Order = typename Traits::Order;
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto aligned = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(aligned);
+
+  for (Algo algo : {Algo::kVQStableSort, Algo::kStdStableSort}) {
+    for (Dist dist : {Dist::kUniform8, Dist::kUniform16, Dist::kUniform32}) {
+      std::vector<double> seconds;
+      for (size_t rep = 0; rep < 10; ++rep) {
+        InputStats<LaneType> input_stats =
+            GenerateInput(dist, aligned.get(), num_lanes);
+
+        const Timestamp t0;
+        Run(algo, HWY_RCAST_ALIGNED(KeyType*, aligned.get()), num_keys, shared,
+            /*thread=*/0, /*k_keys=*/0, Order());
+        seconds.push_back(SecondsSince(t0));
+
+        SortOrderVerifier<Traits>()(algo, input_stats, aligned.get(), num_keys,
+                                    num_keys);
+      }
+      SortResult(algo, dist, num_keys, 1, SummarizeMeasurements(seconds),
+                 sizeof(KeyType), st.KeyString())
+          .Print();
+    }  // dist
+  }    // algo
+}
+
+HWY_NOINLINE void BenchAllStableSort() {
+  // VQStableSort uses dynamic dispatch, hence only run once.
+  if (HWY_TARGET != HWY_STATIC_TARGET) return;
+#if VQSORT_ENABLED
+  for (size_t num_keys : {size_t{10} * 1000, size_t{1000} * 1000}) {
+    BenchStableSort<TraitsLane<OrderAscendingKV64>>(num_keys);
+    BenchStableSort<TraitsLane<OrderAscending<float>>>(num_keys);
+#if HWY_TARGET != HWY_SCALAR
+    BenchStableSort<Traits128<OrderAscendingKV128>>(num_keys);
+#endif
+  }
+#endif  // VQSORT_ENABLED
+}
+
+// Compares counting/radix sort with quicksort to find their crossover point.
+// vq_auto is VQSortStatic, which chooses between them.
+template <class Traits>
+HWY_NOINLINE void BenchRadix(size_t num_keys) {
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  detail::SharedTraits<Traits> st;
+  const SortTag<LaneType> d;
+  auto aligned = hwy::AllocateAligned<LaneType>(num_keys);
+  HWY_ASSERT(aligned);
+  KeyType* keys = HWY_RCAST_ALIGNED(KeyType*, aligned.get());
+  const size_t reps = num_keys > 100 * 1000 ? 10 : 30;
+
+  for (const char* variant : {"vq_quick", "vq_radix", "vq_auto"}) {
+    for (Dist dist : {Dist::kUniform8, Dist::kUniform16, Dist::kUniform32}) {
+      std::vector<double> seconds;
+      for (size_t rep = 0; rep < reps; ++rep) {
+        InputStats<LaneType> input_stats =
+            GenerateInput(dist, aligned.get(), num_keys);
+        const Timestamp t0;
+        if (variant[3] == 'q') {
+          Sort(d, st, aligned.get(), num_keys);
+        } else if (variant[3] == 'r') {
+          VQRadixSortStatic(keys, num_keys, Order());
+        } else {
+          VQSortStatic(keys, num_keys, Order());
+        }
+        seconds.push_back(SecondsSince(t0));
+        SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, aligned.get(),
+                                    num_keys, num_keys);
+      }
+      const double sec = SummarizeMeasurements(seconds);
+      const double bytes = static_cast<double>(num_keys * sizeof(KeyType));
+      printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s\n",
+             hwy::TargetName(HWY_TARGET), variant, st.KeyString(),
+             DistName(dist), static_cast<double>(num_keys),
+             bytes * 1E-6 / sec);
+    }  // dist
+  }    // variant
+}
+
+HWY_NOINLINE void BenchAllRadix() {
+  // Not interested in benchmark results for these targets
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+#if VQSORT_ENABLED
+  for (size_t num_keys : SizesToBenchmark(BenchmarkModes::kPow4)) {
+    BenchRadix<TraitsLane<OrderAscending<uint16_t>>>(num_keys);
+    BenchRadix<TraitsLane<OrderAscending<uint32_t>>>(num_keys);
+    BenchRadix<TraitsLane<OrderAscending<float>>>(num_keys);
+  }
+#endif  // VQSORT_ENABLED
+}
+
+// Scalar k-way merge via a binary heap, the usual alternative to VQMerge.
+template <typename KeyType, class Compare>
+void HeapMerge(const std::vector<const KeyType*>& runs,
+               const std::vector<size_t>& run_sizes, KeyType* out,
+               Compare compare) {
+  using Entry = std::pair<KeyType, size_t>;  // key, run
+  // priority_queue returns the largest, so invert the comparison.
+  const auto entry_after = [&compare](const Entry& a, const Entry& b) {
+    return compare(b.first, a.first);
+  };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(entry_after)> heap(
+      entry_after);
+  std::vector<size_t> pos(runs.size(), 0);
+  for (size_t r = 0; r < runs.size(); ++r) {
+    if (run_sizes[r] != 0) heap.emplace(runs[r][0], r);
+  }
+  while (!heap.empty()) {
+    const size_t r = heap.top().second;
+    *out++ = heap.top().first;
+    heap.pop();
+    if (++pos[r] < run_sizes[r]) heap.emplace(runs[r][pos[r]], r);
+  }
+}
+
+// Merges `num_runs` sorted runs totaling `num_keys` via VQMerge and the
+// standard library (std::merge for two runs, otherwise HeapMerge).
+template <class Traits>
+HWY_NOINLINE void BenchMerge(size_t num_keys, size_t num_runs) {
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  using Compare = hwy::If<Order::IsAscending(), std::less<KeyType>,
+                          std::greater<KeyType>>;
+  detail::SharedTraits<Traits> st;
+  const Dist dist = Dist::kUniform32;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto in = hwy::AllocateAligned<LaneType>(num_lanes);
+  auto out = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(in && out);
+  KeyType* keys = HWY_RCAST_ALIGNED(KeyType*, in.get());
+  KeyType* keys_out = HWY_RCAST_ALIGNED(KeyType*, out.get());
+
+  InputStats<LaneType> input_stats = GenerateInput(dist, in.get(), num_lanes);
+  std::vector<const KeyType*> runs;
+  std::vector<size_t> run_sizes;
+  for (size_t r = 0; r < num_runs; ++r) {
+    const size_t begin = r * num_keys / num_runs;
+    const size_t end = (r + 1) * num_keys / num_runs;
+    VQSort(keys + begin, end - begin, Order());
+    runs.push_back(keys + begin);
+    run_sizes.push_back(end - begin);
+  }
+
+  for (bool vq : {true, false}) {
+    std::vector<double> seconds;
+    for (size_t rep = 0; rep < 10; ++rep) {
+      const Timestamp t0;
+      if (vq) {
+        VQMerge(runs.data(), run_sizes.data(), num_runs, keys_out, Order());
+      } else if (num_runs == 2) {
+        std::merge(runs[0], runs[0] + run_sizes[0], runs[1],
+                   runs[1] + run_sizes[1], keys_out, Compare());
+      } else {
+        HeapMerge(runs, run_sizes, keys_out, Compare());
+      }
+      seconds.push_back(SecondsSince(t0));
+      SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, out.get(),
+                                  num_keys, num_keys);
+    }
+    const double sec = SummarizeMeasurements(seconds);
+    const double bytes = static_cast<double>(num_keys * sizeof(KeyType));
+    printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s (%2zu runs)\n",
+           hwy::TargetName(HWY_TARGET), vq ? "vq_merge" : "std_merge",
+           st.KeyString(), DistName(dist), static_cast<double>(num_keys),
+           bytes * 1E-6 / sec, num_runs);
+  }
+}
+
+HWY_NOINLINE void BenchAllMerge() {
+  // Not interested in benchmark results for these targets
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+#if VQSORT_ENABLED
+  const size_t num_keys = AdjustedReps(size_t{1000} * 1000);
+  for (size_t num_runs : {size_t{2}, size_t{16}}) {
+    BenchMerge<TraitsLane<OrderAscending<float>>>(num_keys, num_runs);
+    BenchMerge<TraitsLane<OrderAscending<int32_t>>>(num_keys, num_runs);
+    BenchMerge<TraitsLane<OrderDescending<int64_t>>>(num_keys, num_runs);
+#if !HAVE_VXSORT && !HAVE_INTEL && HWY_TARGET != HWY_SCALAR
+    BenchMerge<Traits128<OrderAscending128>>(num_keys, num_runs);
+#endif
+  }
+#endif  // VQSORT_ENABLED
+}
+
+// Compares VQSortSegments against calling VQSort for each segment.
+template <class Traits>
+HWY_NOINLINE void BenchSegments(size_t num_keys, size_t max_segment_keys) {
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  detail::SharedTraits<Traits> st;
+  const Dist dist = Dist::kUniform32;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto in = hwy::AllocateAligned<LaneType>(num_lanes);
+  auto out = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(in && out);
+  KeyType* keys = HWY_RCAST_ALIGNED(KeyType*, out.get());
+  (void)GenerateInput(dist, in.get(), num_lanes);
+
+  RandomState rng;
+  std::vector<size_t> offsets = {0};
+  while (offsets.back() < num_keys) {
+    const size_t size = 1 + static_cast<size_t>(rng()) % max_segment_keys;
+    offsets.push_back(HWY_MIN(num_keys, offsets.back() + size));
+  }
+  const size_t num_segments = offsets.size() - 1;
+
+  for (bool segmented : {true, false}) {
+    std::vector<double> seconds;
+    for (size_t rep = 0; rep < 10; ++rep) {
+      CopyBytes(in.get(), out.get(), num_lanes * sizeof(LaneType));
+      const Timestamp t0;
+      if (segmented) {
+        VQSortSegments(keys, offsets.data(), num_segments, Order());
+      } else {
+        for (size_t i = 0; i < num_segments; ++i) {
+          VQSort(keys + offsets[i], offsets[i + 1] - offsets[i], Order());
+        }
+      }
+      seconds.push_back(SecondsSince(t0));
+    }
+    const double sec = SummarizeMeasurements(seconds);
+    const double bytes = static_cast<double>(num_keys * sizeof(KeyType));
+    printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s (segments <= %zu)\n",
+           hwy::TargetName(HWY_TARGET), segmented ? "vq_segments" : "vq_loop",
+           st.KeyString(), DistName(dist), static_cast<double>(num_keys),
+           bytes * 1E-6 / sec, max_segment_keys);
+  }
+}
+
+HWY_NOINLINE void BenchAllSegments() {
+  // VQSortSegments uses dynamic dispatch, hence only run once.
+  if (HWY_TARGET != HWY_STATIC_TARGET) return;
+#if VQSORT_ENABLED
+  const size_t num_keys = AdjustedReps(size_t{1000} * 1000);
+  for (size_t max_segment_keys : {size_t{16}, size_t{64}, size_t{500}}) {
+    BenchSegments<TraitsLane<OrderAscending<uint32_t>>>(num_keys,
+                                                        max_segment_keys);
+    BenchSegments<TraitsLane<OrderAscending<float>>>(num_keys,
+                                                     max_segment_keys);
+    BenchSegments<TraitsLane<OrderAscendingKV64>>(num_keys, max_segment_keys);
+  }
+#endif  // VQSORT_ENABLED
+}
+
+// Compares ExternalSort of a file with a budget of 1/8 of its size against
+// reading all of it, VQSort, and writing the result.
+template <class Traits>
+HWY_NOINLINE void BenchExternalSort(size_t num_keys) {
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  detail::SharedTraits<Traits> st;
+  const Dist dist = Dist::kUniform32;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  const size_t num_bytes = num_keys * sizeof(KeyType);
+  auto in = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(in);
+  KeyType* keys = HWY_RCAST_ALIGNED(KeyType*, in.get());
+  InputStats<LaneType> input_stats = GenerateInput(dist, in.get(), num_lanes);
+
+  const std::string path_in = testing::TempDir() + "bench_external_in";
+  const std::string path_out = testing::TempDir() + "bench_external_out";
+  FILE* f = fopen(path_in.c_str(), "wb");
+  HWY_ASSERT(f && fwrite(keys, sizeof(KeyType), num_keys, f) == num_keys);
+  HWY_ASSERT(fclose(f) == 0);
+
+  for (bool external : {false, true}) {
+    std::vector<double> seconds;
+    for (size_t rep = 0; rep < 3; ++rep) {
+      const Timestamp t0;
+      if (external) {
+        HWY_ASSERT(ExternalSort<KeyType>(path_in.c_str(), path_out.c_str(),
+                                         num_bytes / 8, Order()));
+      } else {
+        f = fopen(path_in.c_str(), "rb");
+        HWY_ASSERT(f && fread(keys, sizeof(KeyType), num_keys, f) == num_keys);
+        HWY_ASSERT(fclose(f) == 0);
+        VQSort(keys, num_keys, Order());
+        f = fopen(path_out.c_str(), "wb");
+        HWY_ASSERT(f &&
+                   fwrite(keys, sizeof(KeyType), num_keys, f) == num_keys);
+        HWY_ASSERT(fclose(f) == 0);
+      }
+      seconds.push_back(SecondsSince(t0));
+
+      f = fopen(path_out.c_str(), "rb");
+      HWY_ASSERT(f && fread(keys, sizeof(KeyType), num_keys, f) == num_keys);
+      HWY_ASSERT(fclose(f) == 0);
+      SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, in.get(),
+                                  num_keys, num_keys);
+    }
+    const double sec = SummarizeMeasurements(seconds);
+    printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s\n",
+           hwy::TargetName(HWY_TARGET), external ? "vq_external" : "vq_file",
+           st.KeyString(), DistName(dist), static_cast<double>(num_keys),
+           static_cast<double>(num_bytes) * 1E-6 / sec);
+  }
+  remove(path_in.c_str());
+  remove(path_out.c_str());
+}
+
+HWY_NOINLINE void BenchAllExternalSort() {
+  // ExternalSort uses dynamic dispatch, hence only run once.
+  if (HWY_TARGET != HWY_STATIC_TARGET) return;
+#if VQSORT_ENABLED
+  const size_t num_keys = AdjustedReps(size_t{16} * 1000 * 1000);
+  BenchExternalSort<TraitsLane<OrderAscending<uint32_t>>>(num_keys);
+#if HWY_HAVE_FLOAT64
+  if (hwy::HaveFloat64()) {
+    BenchExternalSort<TraitsLane<OrderAscending<double>>>(num_keys);
+  }
+#endif
+#endif  // VQSORT_ENABLED
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -470,6 +812,11 @@ HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllBase);
 
 #if !SORT_ONLY_COLD  // skip (warms up vector unit for next run)
 HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllSort);
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllStableSort);
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllRadix);
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllMerge);
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllExternalSort);
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllSegments);
 #endif
 HWY_AFTER_TEST();
 }  // namespace hwy
@@ -0,0 +1,215 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_MERGE_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_MERGE_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_MERGE_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_MERGE_TOGGLE
+#endif
+
+#include "hwy/contrib/sort/vqsort-inl.h"  // MakeTraits, SortTag
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// Bitonic half-cleaner within a vector: for each pair of keys whose index
+// differs only in the bit `dist_lanes / LanesPerKey`, the lower index receives
+// the first and the higher index the last key. Unlike SortPairsDistance1 etc.,
+// `dist_lanes` is a runtime value so that this supports any vector length.
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE V SortPairsDistance(D d, Traits st, V v, size_t dist_lanes) {
+  const RebindToUnsigned<D> du;
+  using TU = TFromD<decltype(du)>;
+  const Vec<decltype(du)> iota = Iota(du, 0);
+  const Vec<decltype(du)> bit = Set(du, static_cast<TU>(dist_lanes));
+  // 128-bit keys: dist_lanes is even, hence both lanes of a key stay together.
+  const V swapped = TableLookupLanes(v, IndicesFromVec(d, Xor(iota, bit)));
+  const Mask<D> is_upper = RebindMask(d, TestBit(iota, bit));
+  return IfThenElse(is_upper, st.Last(d, v, swapped), st.First(d, v, swapped));
+}
+
+// Inputs are each sorted. Afterwards, `v0` holds the first and `v1` the last
+// keys of their union, both sorted. This is a bitonic merge: reversing v1
+// turns the concatenation into a bitonic sequence, and after the first Sort2,
+// each vector is bitonic and only requires log2(keys per vector) half-cleaners.
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE void Merge2Vectors(D d, Traits st, V& v0, V& v1) {
+  v1 = st.ReverseKeys(d, v1);
+  st.Sort2(d, v0, v1);
+  for (size_t dist = Lanes(d) / 2; dist >= st.LanesPerKey(); dist /= 2) {
+    v0 = SortPairsDistance(d, st, v0, dist);
+    v1 = SortPairsDistance(d, st, v1, dist);
+  }
+}
+
+// Scalar merge for short inputs and the remainders. Returns `out` advanced past
+// the num_a + num_b lanes written.
+template <class Traits, typename T>
+HWY_INLINE T* MergeScalar(Traits st, const T* HWY_RESTRICT a, size_t num_a,
+                          const T* HWY_RESTRICT b, size_t num_b,
+                          T* HWY_RESTRICT out) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  size_t ia = 0;
+  size_t ib = 0;
+  while (ia < num_a && ib < num_b) {
+    // Prefer `a` for equivalent keys.
+    if (st.Compare1(b + ib, a + ia)) {
+      CopyBytes<kLPK * sizeof(T)>(b + ib, out);
+      ib += kLPK;
+    } else {
+      CopyBytes<kLPK * sizeof(T)>(a + ia, out);
+      ia += kLPK;
+    }
+    out += kLPK;
+  }
+  CopyBytes(a + ia, out, (num_a - ia) * sizeof(T));
+  out += num_a - ia;
+  CopyBytes(b + ib, out, (num_b - ib) * sizeof(T));
+  out += num_b - ib;
+  return out;
+}
+
+// Returns the number of NaN at the end of keys[0, num), which is where VQSort
+// places them for both orders.
+template <typename T, HWY_IF_FLOAT(T)>
+HWY_INLINE size_t CountTrailingNaN(const T* HWY_RESTRICT keys, size_t num) {
+  size_t num_nan = 0;
+  while (num_nan < num && ScalarIsNaN(keys[num - 1 - num_nan])) ++num_nan;
+  return num_nan;
+}
+template <typename T, HWY_IF_NOT_FLOAT(T)>
+HWY_INLINE size_t CountTrailingNaN(const T* HWY_RESTRICT, size_t) {
+  return 0;
+}
+
+#endif  // VQSORT_ENABLED
+
+}  // namespace detail
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// Merges a[0, num_a) and b[0, num_b), which are each sorted according to `st`,
+// into out[0, num_a + num_b), which must not overlap the inputs. As with Sort,
+// `num_*` are in units of `T`, not keys. Equivalent keys are not necessarily
+// ordered by their input. Does not allocate memory.
+template <class D, class Traits, typename T>
+void Merge(D d, Traits st, const T* HWY_RESTRICT a, size_t num_a,
+           const T* HWY_RESTRICT b, size_t num_b, T* HWY_RESTRICT out) {
+#if HWY_MAX_BYTES > 64
+  // Also bounds the size of `buf`.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return Merge(CappedTag<T, 64 / sizeof(T)>(), st, a, num_a, b, num_b, out);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  // SIMD Min/Max do not order NaN, so exclude and then append them.
+  const size_t nan_a = detail::CountTrailingNaN(a, num_a);
+  const size_t nan_b = detail::CountTrailingNaN(b, num_b);
+  num_a -= nan_a;
+  num_b -= nan_b;
+  T* HWY_RESTRICT out_nan = out + num_a + num_b;
+  CopyBytes(a + num_a, out_nan, nan_a * sizeof(T));
+  CopyBytes(b + num_b, out_nan + nan_a, nan_b * sizeof(T));
+
+  const size_t N = Lanes(d);
+  if (num_a < N || num_b < N) {
+    (void)detail::MergeScalar(st, a, num_a, b, num_b, out);
+    return;
+  }
+
+  using V = Vec<D>;
+  V v0 = LoadU(d, a);
+  V v1 = LoadU(d, b);
+  size_t ia = N;
+  size_t ib = N;
+  for (;;) {
+    detail::Merge2Vectors(d, st, v0, v1);
+    StoreU(v0, d, out);
+    out += N;
+    v0 = v1;
+
+    // v0 is now the last keys seen so far. The next vector must come from the
+    // input whose next key is first, otherwise the other input may have keys
+    // that precede the next vector we output.
+    const bool more_a = ia < num_a;
+    const bool more_b = ib < num_b;
+    const bool take_a = more_a && (!more_b || !st.Compare1(b + ib, a + ia));
+    if (take_a) {
+      if (num_a - ia < N) break;
+      v1 = LoadU(d, a + ia);
+      ia += N;
+    } else {
+      if (num_b - ib < N) break;  // also if both are empty
+      v1 = LoadU(d, b + ib);
+      ib += N;
+    }
+  }
+
+  // The remaining keys: v0 and fewer than N of one input, plus any number of
+  // the other. Merge the first two into `tmp`, which is short, and then that
+  // with the remainder of the other input.
+  HWY_ALIGN T buf[64 / sizeof(T)];
+  HWY_ALIGN T tmp[2 * 64 / sizeof(T)];
+  StoreU(v0, d, buf);
+  const bool short_a = num_a - ia < N;
+  const T* short_keys = short_a ? a + ia : b + ib;
+  const size_t num_short = short_a ? num_a - ia : num_b - ib;
+  const T* long_keys = short_a ? b + ib : a + ia;
+  const size_t num_long = short_a ? num_b - ib : num_a - ia;
+  const T* end_tmp = detail::MergeScalar(st, buf, N, short_keys, num_short, tmp);
+  (void)detail::MergeScalar(st, tmp, static_cast<size_t>(end_tmp - tmp),
+                            long_keys, num_long, out);
+}
+
+#endif  // VQSORT_ENABLED
+
+// Simpler interface matching VQMerge(), but without dynamic dispatch. Uses the
+// instructions available in the current target (HWY_NAMESPACE). Supports the
+// same key types as VQSortStatic. `num_a`, `num_b` are in units of keys.
+template <typename Key, class Order>
+void VQMergeStatic(const Key* HWY_RESTRICT a, const size_t num_a,
+                   const Key* HWY_RESTRICT b, const size_t num_b,
+                   Key* HWY_RESTRICT out, Order) {
+#if VQSORT_ENABLED
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  Merge(d, st, reinterpret_cast<const LaneType*>(a), num_a * st.LanesPerKey(),
+        reinterpret_cast<const LaneType*>(b), num_b * st.LanesPerKey(),
+        reinterpret_cast<LaneType*>(out));
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_MERGE_TOGGLE
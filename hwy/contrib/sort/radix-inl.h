@@ -0,0 +1,398 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Counting sort and LSD radix sort for 16 and 32-bit keys. Used by VQSortStatic
+// when profitable, and by VQRadixSortStatic.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_RADIX_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_RADIX_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_RADIX_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_RADIX_TOGGLE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/algo/copy-inl.h"  // Fill
+#include "hwy/contrib/sort/shared-inl.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+#if VQSORT_ENABLED || HWY_IDE
+
+struct RadixConstants {
+  // Upper bound on the number of bins for counting sort. The histogram then
+  // fits in L2, and all 16-bit keys qualify.
+  static constexpr size_t kMaxCountingBins = size_t{1} << 16;
+  // Wider ranges require LSD radix sort with up to this many bits per pass.
+  // The (at most four) histograms for 32-bit keys then fit in L1.
+  static constexpr size_t kMaxDigitBits = 10;
+
+  // VQSortStatic uses counting sort if there are at least this many keys and
+  // their range is at most kBinsPerKey times the number of keys. Otherwise,
+  // clearing and scanning the histogram costs more than the quicksort.
+  static constexpr size_t kMinKeys = 4096;
+  static constexpr size_t kBinsPerKey = 4;
+  // Number of keys VQSortStatic inspects for 32-bit keys to decide whether
+  // their range is narrow enough before reading all of them.
+  static constexpr size_t kNumSamples = 16;
+};
+
+// Converts between keys and unsigned "ordered" bits whose ascending order is
+// the `Order` of the keys. NaN are not ordered and must be handled separately.
+// `Key` is one of the 16 or 32-bit lane types.
+template <typename Key, class Order>
+struct RadixKey {
+  using TU = MakeUnsigned<Key>;
+  // Same as Key for floating-point keys; ExponentMask requires a float type.
+  using TF = hwy::If<IsFloat<Key>(), Key,
+                     hwy::If<sizeof(Key) == 2, float16_t, float>>;
+  static constexpr TU kSign = SignMask<TU>();
+
+  static HWY_INLINE TU ToOrdered(TU bits) {
+    if (IsFloat<Key>()) {
+      // Negative: reverse the order of the magnitude. Positive: after negative.
+      bits ^= (bits & kSign) ? LimitsMax<TU>() : kSign;
+    } else if (IsSigned<Key>()) {
+      bits ^= kSign;
+    }
+    return Order::IsAscending() ? bits : static_cast<TU>(~bits);
+  }
+
+  static HWY_INLINE TU FromOrdered(TU ordered) {
+    if (!Order::IsAscending()) ordered = static_cast<TU>(~ordered);
+    if (IsFloat<Key>()) {
+      ordered ^= (ordered & kSign) ? kSign : LimitsMax<TU>();
+    } else if (IsSigned<Key>()) {
+      ordered ^= kSign;
+    }
+    return ordered;
+  }
+
+  static HWY_INLINE bool IsNaN(TU bits) {
+    return IsFloat<Key>() &&
+           static_cast<TU>(bits & ~kSign) > ExponentMask<TF>();
+  }
+
+  // Vector versions of the above. These operate on unsigned lanes so that
+  // float16_t keys do not require HWY_HAVE_FLOAT16.
+  template <class DU>
+  static HWY_INLINE Vec<DU> ToOrdered(DU du, Vec<DU> bits) {
+    const RebindToSigned<DU> di;
+    const Vec<DU> sign = Set(du, kSign);
+    if (IsFloat<Key>()) {
+      const Vec<DU> negative = BitCast(du, BroadcastSignBit(BitCast(di, bits)));
+      bits = Xor(bits, Or(negative, sign));
+    } else if (IsSigned<Key>()) {
+      bits = Xor(bits, sign);
+    }
+    return Order::IsAscending() ? bits : Not(bits);
+  }
+
+  template <class DU>
+  static HWY_INLINE Vec<DU> FromOrdered(DU du, Vec<DU> ordered) {
+    const RebindToSigned<DU> di;
+    const Vec<DU> sign = Set(du, kSign);
+    if (!Order::IsAscending()) ordered = Not(ordered);
+    if (IsFloat<Key>()) {
+      const Vec<DU> positive =
+          BitCast(du, BroadcastSignBit(BitCast(di, ordered)));
+      ordered = Xor(ordered, Or(Not(positive), sign));
+    } else if (IsSigned<Key>()) {
+      ordered = Xor(ordered, sign);
+    }
+    return ordered;
+  }
+
+  template <class DU>
+  static HWY_INLINE Mask<DU> IsNaN(DU du, Vec<DU> bits) {
+    if (!IsFloat<Key>()) return MaskFalse(du);
+    const Vec<DU> abs = And(bits, Set(du, static_cast<TU>(~kSign)));
+    return Gt(abs, Set(du, ExponentMask<TF>()));
+  }
+
+  // VQSort replaces NaN with this canonical NaN (see NaN()).
+  static constexpr TU kNaN = static_cast<TU>(~kSign);
+};
+
+template <typename TU>
+struct RadixStats {
+  TU min;  // smallest ordered bits of any non-NaN key
+  TU max;
+  size_t num_nan;
+};
+
+// Returns the range of the ordered bits and the number of NaN.
+template <class RK, class DU, typename TU = TFromD<DU>>
+HWY_INLINE RadixStats<TU> ComputeRadixStats(DU du,
+                                            const TU* HWY_RESTRICT keys,
+                                            size_t num) {
+  const size_t N = Lanes(du);
+  const Vec<DU> kMax = Set(du, LimitsMax<TU>());
+  Vec<DU> vmin = kMax;
+  Vec<DU> vmax = Zero(du);
+  size_t num_nan = 0;
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const Vec<DU> bits = LoadU(du, keys + i);
+      const Vec<DU> ordered = RK::ToOrdered(du, bits);
+      const Mask<DU> is_nan = RK::IsNaN(du, bits);
+      num_nan += CountTrue(du, is_nan);
+      vmin = Min(vmin, IfThenElse(is_nan, kMax, ordered));
+      vmax = Max(vmax, IfThenZeroElse(is_nan, ordered));
+    }
+  }
+  RadixStats<TU> stats = {ReduceMin(du, vmin), ReduceMax(du, vmax), num_nan};
+  for (; i < num; ++i) {
+    if (RK::IsNaN(keys[i])) {
+      ++stats.num_nan;
+      continue;
+    }
+    const TU ordered = RK::ToOrdered(keys[i]);
+    stats.min = HWY_MIN(stats.min, ordered);
+    stats.max = HWY_MAX(stats.max, ordered);
+  }
+  return stats;
+}
+
+// Returns the number of bins that counting sort would require, judging only by
+// `kNumSamples` keys. This is a lower bound.
+template <class RK, typename TU>
+HWY_INLINE size_t SampledRadixBins(const TU* HWY_RESTRICT keys, size_t num) {
+  TU min = LimitsMax<TU>();
+  TU max = 0;
+  const size_t stride = num / RadixConstants::kNumSamples;
+  for (size_t i = 0; i < RadixConstants::kNumSamples; ++i) {
+    const TU bits = keys[i * stride];
+    if (RK::IsNaN(bits)) continue;
+    const TU ordered = RK::ToOrdered(bits);
+    min = HWY_MIN(min, ordered);
+    max = HWY_MAX(max, ordered);
+  }
+  return min > max ? 0 : static_cast<size_t>(max - min) + 1;
+}
+
+template <class RK, class DU, typename TU = TFromD<DU>>
+HWY_INLINE void FillNaN(DU du, TU* HWY_RESTRICT keys, size_t num,
+                        size_t num_nan) {
+  if (num_nan != 0) Fill(du, RK::kNaN, num_nan, keys + num - num_nan);
+}
+
+// Counting sort for ordered bits in [stats.min, stats.min + num_bins). Reads
+// `keys` once, then writes each key value as often as it occurred. Returns
+// false if allocation failed, in which case `keys` are unchanged.
+template <class RK, typename Count, class DU, typename TU = TFromD<DU>>
+HWY_NOINLINE bool CountingSort(DU du, TU* HWY_RESTRICT keys, size_t num,
+                               const RadixStats<TU>& stats, size_t num_bins) {
+  AlignedFreeUniquePtr<Count[]> counts = AllocateAligned<Count>(num_bins);
+  if (HWY_UNLIKELY(!counts)) return false;
+  ZeroBytes(counts.get(), num_bins * sizeof(Count));
+
+  // NaN are counted as the last key, which we later overwrite with NaN.
+  const TU nan_bin = static_cast<TU>(stats.max - stats.min);
+  for (size_t i = 0; i < num; ++i) {
+    const TU bits = keys[i];
+    const TU bin = RK::IsNaN(bits)
+                       ? nan_bin
+                       : static_cast<TU>(RK::ToOrdered(bits) - stats.min);
+    ++counts[bin];
+  }
+
+  TU* HWY_RESTRICT out = keys;
+  for (size_t bin = 0; bin < num_bins; ++bin) {
+    const size_t count = static_cast<size_t>(counts[bin]);
+    if (count == 0) continue;
+    const TU bits = RK::FromOrdered(static_cast<TU>(stats.min + bin));
+    Fill(du, bits, count, out);
+    out += count;
+  }
+  FillNaN<RK>(du, keys, num, stats.num_nan);
+  return true;
+}
+
+// LSD radix sort of the ordered bits minus stats.min, with as few digits as
+// required for the range. Each pass moves all keys to the other of `keys` and
+// a temporary buffer; passes where all keys have the same digit are skipped.
+// Returns false if allocation failed, in which case `keys` are unchanged.
+template <class RK, typename Count, class DU, typename TU = TFromD<DU>>
+HWY_NOINLINE bool LsdRadixSort(DU du, TU* HWY_RESTRICT keys, size_t num,
+                               const RadixStats<TU>& stats) {
+  const size_t range = static_cast<size_t>(stats.max - stats.min);
+  HWY_DASSERT(range != 0);
+  const size_t bits = 32 - Num0BitsAboveMS1Bit_Nonzero32(
+                               static_cast<uint32_t>(range));
+  const size_t num_passes = DivCeil(bits, RadixConstants::kMaxDigitBits);
+  const size_t digit_bits = DivCeil(bits, num_passes);
+  const size_t num_digits = size_t{1} << digit_bits;
+  const TU digit_mask = static_cast<TU>(num_digits - 1);
+
+  AlignedFreeUniquePtr<TU[]> buf = AllocateAligned<TU>(num);
+  AlignedFreeUniquePtr<Count[]> counts =
+      AllocateAligned<Count>(num_passes * num_digits);
+  if (HWY_UNLIKELY(!buf || !counts)) return false;
+  ZeroBytes(counts.get(), num_passes * num_digits * sizeof(Count));
+
+  // Convert in place to ordered bits relative to the minimum, and compute the
+  // histograms of all passes at once. NaN become the largest value.
+  const size_t N = Lanes(du);
+  const Vec<DU> min = Set(du, stats.min);
+  const Vec<DU> nan_ordered = Set(du, static_cast<TU>(range));
+  const auto histogram = [&](TU ordered) {
+    for (size_t pass = 0; pass < num_passes; ++pass) {
+      const size_t digit = (ordered >> (pass * digit_bits)) & digit_mask;
+      ++counts[pass * num_digits + digit];
+    }
+  };
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const Vec<DU> v = LoadU(du, keys + i);
+      const Vec<DU> ordered = Sub(RK::ToOrdered(du, v), min);
+      StoreU(IfThenElse(RK::IsNaN(du, v), nan_ordered, ordered), du, keys + i);
+      for (size_t j = 0; j < N; ++j) histogram(keys[i + j]);
+    }
+  }
+  for (; i < num; ++i) {
+    keys[i] = RK::IsNaN(keys[i])
+                  ? static_cast<TU>(range)
+                  : static_cast<TU>(RK::ToOrdered(keys[i]) - stats.min);
+    histogram(keys[i]);
+  }
+
+  TU* HWY_RESTRICT from = keys;
+  TU* HWY_RESTRICT to = buf.get();
+  for (size_t pass = 0; pass < num_passes; ++pass) {
+    Count* HWY_RESTRICT offsets = counts.get() + pass * num_digits;
+    const size_t shift = pass * digit_bits;
+    if (static_cast<size_t>(offsets[(from[0] >> shift) & digit_mask]) == num) {
+      continue;
+    }
+    // Exclusive prefix sum.
+    Count sum = 0;
+    for (size_t digit = 0; digit < num_digits; ++digit) {
+      const Count count = offsets[digit];
+      offsets[digit] = sum;
+      sum += count;
+    }
+    for (i = 0; i < num; ++i) {
+      const TU ordered = from[i];
+      to[offsets[(ordered >> shift) & digit_mask]++] = ordered;
+    }
+    TU* HWY_RESTRICT tmp = from;
+    from = to;
+    to = tmp;
+  }
+
+  // Convert back, possibly in place.
+  i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const Vec<DU> ordered = Add(LoadU(du, from + i), min);
+      StoreU(RK::FromOrdered(du, ordered), du, keys + i);
+    }
+  }
+  for (; i < num; ++i) {
+    keys[i] = RK::FromOrdered(static_cast<TU>(from[i] + stats.min));
+  }
+  FillNaN<RK>(du, keys, num, stats.num_nan);
+  return true;
+}
+
+// Counters must hold `num`; 32-bit are sufficient and faster in most cases.
+template <class RK, class DU, typename TU = TFromD<DU>>
+HWY_INLINE bool RadixSortWithStats(DU du, TU* HWY_RESTRICT keys, size_t num,
+                                   const RadixStats<TU>& stats) {
+  if (stats.num_nan == num) {
+    FillNaN<RK>(du, keys, num, num);
+    return true;
+  }
+  const size_t num_bins = static_cast<size_t>(stats.max - stats.min) + 1;
+  const bool small = num <= LimitsMax<uint32_t>();
+  if (num_bins <= RadixConstants::kMaxCountingBins) {
+    return small ? CountingSort<RK, uint32_t>(du, keys, num, stats, num_bins)
+                 : CountingSort<RK, uint64_t>(du, keys, num, stats, num_bins);
+  }
+  return small ? LsdRadixSort<RK, uint32_t>(du, keys, num, stats)
+               : LsdRadixSort<RK, uint64_t>(du, keys, num, stats);
+}
+
+// Sorts `num` keys of a 16 or 32-bit lane type. Uses counting sort if the range
+// of the keys is narrow enough, otherwise LSD radix sort, which allocates a
+// copy of the keys. As with VQSort, NaN are moved to the back and replaced with
+// the canonical NaN. Returns false if allocation failed, in which case `keys`
+// are unchanged.
+template <typename Key, class Order>
+bool RadixSort(Key* HWY_RESTRICT keys, size_t num, Order) {
+  static_assert(sizeof(Key) == 2 || sizeof(Key) == 4, "Unsupported key");
+  using RK = RadixKey<Key, Order>;
+  using TU = typename RK::TU;
+  const SortTag<TU> du;
+  TU* HWY_RESTRICT bits = reinterpret_cast<TU*>(keys);
+  if (num <= 1) return true;
+  return RadixSortWithStats<RK>(du, bits, num,
+                                ComputeRadixStats<RK>(du, bits, num));
+}
+
+// Called by VQSortStatic: only uses counting sort, because it does not require
+// a copy of the keys, and only if that is likely faster than the quicksort.
+// Returns false if the keys have not been sorted.
+template <typename Key, class Order,
+          HWY_IF_T_SIZE_ONE_OF(Key, (1 << 2) | (1 << 4))>
+HWY_INLINE bool MaybeRadixSort(Key* HWY_RESTRICT keys, size_t num, Order) {
+  using RK = RadixKey<Key, Order>;
+  using TU = typename RK::TU;
+  if (num < RadixConstants::kMinKeys) return false;
+  const size_t max_bins = HWY_MIN(RadixConstants::kMaxCountingBins,
+                                  num * RadixConstants::kBinsPerKey);
+  TU* HWY_RESTRICT bits = reinterpret_cast<TU*>(keys);
+  // Avoid reading all keys if a few already indicate the range is too large.
+  if (sizeof(Key) == 4 && SampledRadixBins<RK>(bits, num) > max_bins) {
+    return false;
+  }
+
+  const SortTag<TU> du;
+  const RadixStats<TU> stats = ComputeRadixStats<RK>(du, bits, num);
+  if (stats.num_nan != num &&
+      static_cast<size_t>(stats.max - stats.min) + 1 > max_bins) {
+    return false;
+  }
+  return RadixSortWithStats<RK>(du, bits, num, stats);
+}
+
+template <typename Key, class Order,
+          HWY_IF_T_SIZE_ONE_OF(Key, (1 << 8) | (1 << 16))>
+HWY_INLINE bool MaybeRadixSort(Key* HWY_RESTRICT, size_t, Order) {
+  return false;
+}
+
+#endif  // VQSORT_ENABLED
+
+}  // namespace detail
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_RADIX_TOGGLE
@@ -63,8 +63,11 @@ struct SortResult {
         key_name(key_name) {}
 
   void Print() const {
+    // Parallel algorithms sort a single array; otherwise, each thread sorts
+    // its own array of num_keys.
+    const size_t num_arrays = IsParallel(algo) ? 1 : num_threads;
     const double bytes = static_cast<double>(num_keys) *
-                         static_cast<double>(num_threads) *
+                         static_cast<double>(num_arrays) *
                          static_cast<double>(sizeof_key);
     printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s (%2zu threads)\n",
            hwy::TargetName(target), AlgoName(algo), key_name.c_str(),
@@ -16,8 +16,11 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <algorithm>  // std::sort, std::stable_sort
+#include <memory>
 #include <numeric>  // std::iota
 #include <random>
+#include <string>
 #include <vector>
 
 #include "hwy/aligned_allocator.h"  // IsAligned
@@ -33,6 +36,7 @@
 #include "hwy/highway.h"
 // After highway.h
 #include "hwy/contrib/sort/algo-inl.h"
+#include "hwy/contrib/sort/merge-inl.h"
 #include "hwy/contrib/sort/result-inl.h"
 #include "hwy/contrib/sort/vqsort-inl.h"  // BaseCase
 #include "hwy/print-inl.h"
@@ -102,6 +106,15 @@ void TestAnySort(const std::vector<Algo>& algos, size_t num_lanes) {
   SharedState shared;
   SharedTraits<Traits> st;
 
+  // Only construct (and spin up threads) if required.
+  std::unique_ptr<hwy::ThreadPool> pool;
+  for (Algo algo : algos) {
+    if (IsParallel(algo) && !pool) {
+      pool.reset(new hwy::ThreadPool(hwy::HaveThreadingSupport() ? 4 : 0));
+      shared.thread_pool = pool.get();
+    }
+  }
+
   constexpr size_t kLPK = st.LanesPerKey();
   num_lanes = hwy::RoundUpTo(num_lanes, kLPK);
   const size_t num_keys = num_lanes / kLPK;
@@ -252,6 +265,525 @@ void TestAllSelect() {
   }
 }
 
+void TestAllParallelSort() {
+  const std::vector<Algo> algos{Algo::kParallelVQSort};
+
+  // The larger sizes exceed the threshold for actually using the pool.
+  for (int num : {504, 70 * 1000, 300 * 1000}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    CallAllSortTraits(algos, num_lanes);
+  }
+}
+
+// Keys with many duplicates, so that the tie-breaking by index is exercised.
+template <typename Key>
+void MakeArgSortKey(uint64_t bits, Key& key) {
+  key = static_cast<Key>(bits % 1000);
+}
+void MakeArgSortKey(uint64_t bits, int32_t& key) {
+  key = static_cast<int32_t>(bits % 1000) - 500;
+}
+void MakeArgSortKey(uint64_t bits, float16_t& key) {
+  key = F16FromF32(static_cast<float>(static_cast<int>(bits % 1000) - 500));
+}
+void MakeArgSortKey(uint64_t bits, float& key) {
+  key = (bits % 997 == 0) ? BitCastScalar<float>(0x7FC00000u)
+                          : static_cast<float>(static_cast<int>(bits % 1000) -
+                                               500) * 0.25f;
+}
+void MakeArgSortKey(uint64_t bits, double& key) {
+  key = (bits % 997 == 0) ? BitCastScalar<double>(0x7FF8000000000000ull)
+                          : static_cast<double>(static_cast<int>(bits % 1000) -
+                                                500) * 0.25;
+}
+void MakeArgSortKey(uint64_t bits, K32V32& key) {
+  key.key = static_cast<uint32_t>(bits % 1000);
+  key.value = static_cast<uint32_t>(bits >> 32);
+}
+void MakeArgSortKey(uint64_t bits, K64V64& key) {
+  key.key = bits % 1000;
+  key.value = bits >> 32;
+}
+void MakeArgSortKey(uint64_t bits, uint128_t& key) {
+  key.hi = bits % 30;
+  key.lo = (bits >> 32) % 100;
+}
+
+template <typename Key>
+bool ArgSortIsNaN(const Key&) {
+  return false;
+}
+bool ArgSortIsNaN(float16_t key) { return ScalarIsNaN(key); }
+bool ArgSortIsNaN(float key) { return ScalarIsNaN(key); }
+bool ArgSortIsNaN(double key) { return ScalarIsNaN(key); }
+
+// VQSort's ordering: NaN are last for both orders.
+template <class Order, typename Key>
+bool ArgSortBefore(const Key& a, const Key& b) {
+  if (ArgSortIsNaN(a)) return false;
+  if (ArgSortIsNaN(b)) return true;
+  return Order::IsAscending() ? (a < b) : (b < a);
+}
+
+template <typename Key, typename Index, class Order>
+void TestArgSort(size_t n) {
+  std::mt19937_64 rng(static_cast<uint64_t>(n) * 12345);
+  std::vector<Key> keys(n);
+  for (size_t i = 0; i < n; ++i) {
+    MakeArgSortKey(rng(), keys[i]);
+  }
+  const std::vector<Key> copy = keys;
+  std::vector<Index> indices(n);
+  VQArgSort(keys.data(), n, indices.data(), Order());
+
+  // Keys are unchanged.
+  HWY_ASSERT(n == 0 || BytesEqual(copy.data(), keys.data(), n * sizeof(Key)));
+
+  // Permutation
+  std::vector<bool> seen(n);
+  for (size_t i = 0; i < n; ++i) {
+    HWY_ASSERT(indices[i] < n);
+    HWY_ASSERT(!seen[indices[i]]);
+    seen[indices[i]] = true;
+  }
+
+  // Sorted, and equivalent keys are in order of their index.
+  for (size_t i = 1; i < n; ++i) {
+    const Key& prev = keys[indices[i - 1]];
+    const Key& cur = keys[indices[i]];
+    if (ArgSortBefore<Order>(cur, prev)) {
+      HWY_ABORT("ArgSort: %zu-byte keys not sorted at %zu of %zu\n",
+                sizeof(Key), i, n);
+    }
+    if (!ArgSortBefore<Order>(prev, cur)) {
+      HWY_ASSERT(indices[i - 1] < indices[i]);
+    }
+  }
+}
+
+template <typename Key>
+void TestArgSortAllOrdersAndIndices() {
+  for (size_t n : {size_t{0}, size_t{1}, size_t{3}, size_t{200},
+                   AdjustedReps(size_t{5000})}) {
+    TestArgSort<Key, uint32_t, SortAscending>(n);
+    TestArgSort<Key, uint32_t, SortDescending>(n);
+    TestArgSort<Key, uint64_t, SortAscending>(n);
+    TestArgSort<Key, uint64_t, SortDescending>(n);
+  }
+}
+
+// VQArgSort dispatches to the best target, so this is independent of the
+// current HWY_TARGET.
+void TestAllArgSort() {
+  TestArgSortAllOrdersAndIndices<uint16_t>();
+  TestArgSortAllOrdersAndIndices<int32_t>();
+  TestArgSortAllOrdersAndIndices<uint64_t>();
+  if (hwy::HaveFloat16()) {
+    TestArgSortAllOrdersAndIndices<float16_t>();
+  }
+  TestArgSortAllOrdersAndIndices<float>();
+  if (hwy::HaveFloat64()) {
+    TestArgSortAllOrdersAndIndices<double>();
+  }
+  TestArgSortAllOrdersAndIndices<K32V32>();
+  TestArgSortAllOrdersAndIndices<K64V64>();
+  TestArgSortAllOrdersAndIndices<uint128_t>();
+}
+
+// Also distinguishes -0 and +0, which are equivalent but not identical.
+template <typename Key>
+void MakeStableSortKey(uint64_t bits, Key& key) {
+  MakeArgSortKey(bits, key);
+}
+void MakeStableSortKey(uint64_t bits, float& key) {
+  MakeArgSortKey(bits, key);
+  if (key == 0.0f && (bits >> 63)) key = -key;
+}
+
+template <typename Key, class Order>
+void TestStableSort(size_t n) {
+  std::mt19937_64 rng(static_cast<uint64_t>(n) * 54321);
+  std::vector<Key> keys(n);
+  for (size_t i = 0; i < n; ++i) {
+    MakeStableSortKey(rng(), keys[i]);
+  }
+  std::vector<Key> expected = keys;
+  std::stable_sort(expected.begin(), expected.end(), ArgSortBefore<Order, Key>);
+  VQStableSort(keys.data(), n, Order());
+  for (size_t i = 0; i < n; ++i) {
+    if (!BytesEqual(&expected[i], &keys[i], sizeof(Key))) {
+      HWY_ABORT("StableSort: %zu-byte keys mismatch at %zu of %zu\n",
+                sizeof(Key), i, n);
+    }
+  }
+}
+
+template <typename Key>
+void TestStableSortAllOrders() {
+  for (size_t n : {size_t{0}, size_t{1}, size_t{3}, size_t{200},
+                   AdjustedReps(size_t{5000})}) {
+    TestStableSort<Key, SortAscending>(n);
+    TestStableSort<Key, SortDescending>(n);
+  }
+}
+
+// VQStableSort dispatches to the best target, so this is independent of the
+// current HWY_TARGET.
+void TestAllStableSort() {
+  TestStableSortAllOrders<uint16_t>();
+  TestStableSortAllOrders<int32_t>();
+  TestStableSortAllOrders<uint64_t>();
+  if (hwy::HaveFloat16()) {
+    TestStableSortAllOrders<float16_t>();
+  }
+  TestStableSortAllOrders<float>();
+  if (hwy::HaveFloat64()) {
+    TestStableSortAllOrders<double>();
+  }
+  TestStableSortAllOrders<K32V32>();
+  TestStableSortAllOrders<K64V64>();
+  TestStableSortAllOrders<uint128_t>();
+}
+
+// Also checks NaN, which GenerateInput avoids. If `wide`, the range of the keys
+// requires LSD radix sort instead of counting sort.
+template <typename Key, class Order>
+void TestRadixSortNaN(size_t num_keys, bool wide) {
+  using TU = MakeUnsigned<Key>;
+  // No denormals, see CallAllSortTraits.
+  const TU one =
+      static_cast<TU>((ExponentMask<Key>() >> 1) & ExponentMask<Key>());
+  const TU mantissa = wide ? MantissaMask<Key>() : TU{0x3FF};
+  std::mt19937 rng(static_cast<uint32_t>(num_keys));
+  std::vector<Key> keys(num_keys);
+  for (size_t i = 0; i < num_keys; ++i) {
+    TU bits = static_cast<TU>(one | (rng() & mantissa));
+    if (wide && (rng() & 1)) bits = static_cast<TU>(bits | SignMask<TU>());
+    if (i % 97 == 0) bits = static_cast<TU>(ExponentMask<Key>() | 1);  // NaN
+    keys[i] = BitCastScalar<Key>(bits);
+  }
+  std::vector<Key> expected = keys;
+  std::sort(expected.begin(), expected.end(), ArgSortBefore<Order, Key>);
+  VQRadixSort(keys.data(), num_keys, Order());
+  for (size_t i = 0; i < num_keys; ++i) {
+    // NaN may have any payload.
+    const bool nan = ArgSortIsNaN(expected[i]);
+    if (nan ? !ArgSortIsNaN(keys[i])
+            : !BytesEqual(&expected[i], &keys[i], sizeof(Key))) {
+      HWY_ABORT("Radix: %zu-byte keys mismatch at %zu of %zu, wide %d\n",
+                sizeof(Key), i, num_keys, wide);
+    }
+  }
+}
+
+void TestAllRadixSort() {
+  const std::vector<Algo> algos{Algo::kVQRadixSort};
+  // Includes inputs large enough for VQSort to also use counting sort.
+  for (int num : {129, 3 * 1000, 34567}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    TestAnySort<TraitsLane<OrderAscending<int16_t>>>(algos, num_lanes);
+    TestAnySort<TraitsLane<OtherOrder<uint16_t>>>(algos, num_lanes);
+    TestAnySort<TraitsLane<OtherOrder<int32_t>>>(algos, num_lanes);
+    TestAnySort<TraitsLane<OrderAscending<uint32_t>>>(algos, num_lanes);
+#if HWY_HAVE_FLOAT16  // #if protects algo-inl.h's GenerateRandom
+    if (hwy::HaveFloat16()) {
+      TestAnySort<TraitsLane<OtherOrder<float16_t>>>(algos, num_lanes);
+    }
+#endif
+    TestAnySort<TraitsLane<OrderAscending<float>>>(algos, num_lanes);
+  }
+
+  for (size_t num_keys : {size_t{1}, size_t{100}, size_t{20000}}) {
+    for (bool wide : {false, true}) {
+      TestRadixSortNaN<float, SortAscending>(num_keys, wide);
+      TestRadixSortNaN<float, SortDescending>(num_keys, wide);
+    }
+    if (hwy::HaveFloat16()) {
+      TestRadixSortNaN<float16_t, SortAscending>(num_keys, /*wide=*/false);
+      TestRadixSortNaN<float16_t, SortDescending>(num_keys, /*wide=*/false);
+    }
+  }
+}
+
+template <class Traits>
+void TestAnyMerge(size_t num_keys_a, size_t num_keys_b, size_t num_runs) {
+#if VQSORT_ENABLED
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  SharedTraits<Traits> st;
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t num_keys = num_keys_a + num_keys_b;
+  if (num_keys == 0) return;
+
+  // One extra key so that allocations are nonzero.
+  auto a = hwy::AllocateAligned<LaneType>((num_keys_a + 1) * kLPK);
+  auto b = hwy::AllocateAligned<LaneType>((num_keys_b + 1) * kLPK);
+  auto out = hwy::AllocateAligned<LaneType>(num_keys * kLPK);
+  HWY_ASSERT(a && b && out);
+  KeyType* keys_a = HWY_RCAST_ALIGNED(KeyType*, a.get());
+  KeyType* keys_b = HWY_RCAST_ALIGNED(KeyType*, b.get());
+  KeyType* keys_out = HWY_RCAST_ALIGNED(KeyType*, out.get());
+
+  std::mt19937 rng(static_cast<uint32_t>(num_keys * 7 + num_runs));
+  for (Dist dist : AllDist()) {
+    InputStats<LaneType> input_stats;
+    (void)GenerateInput(dist, a.get(), num_keys_a * kLPK);
+    (void)GenerateInput(dist, b.get(), num_keys_b * kLPK);
+    for (size_t i = 0; i < num_keys_a * kLPK; ++i) input_stats.Notify(a[i]);
+    for (size_t i = 0; i < num_keys_b * kLPK; ++i) input_stats.Notify(b[i]);
+
+    // 2-way merge with the static dispatch of the current target.
+    VQSort(keys_a, num_keys_a, Order());
+    VQSort(keys_b, num_keys_b, Order());
+    VQMergeStatic(keys_a, num_keys_a, keys_b, num_keys_b, keys_out, Order());
+    SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, out.get(),
+                                num_keys, num_keys);
+
+    // k-way merge of runs of random sizes, with dynamic dispatch. Generate
+    // the runs by splitting `out` after copying it to `a`/`b`.
+    CopyBytes(keys_out, keys_a, num_keys_a * sizeof(KeyType));
+    CopyBytes(keys_out + num_keys_a, keys_b, num_keys_b * sizeof(KeyType));
+    std::vector<const KeyType*> runs;
+    std::vector<size_t> run_sizes;
+    for (KeyType* keys : {keys_a, keys_b}) {
+      size_t remaining = (keys == keys_a) ? num_keys_a : num_keys_b;
+      for (size_t r = 0; r < num_runs; ++r) {
+        const size_t size = (r == num_runs - 1)
+                                ? remaining
+                                : static_cast<size_t>(rng()) % (remaining + 1);
+        VQSort(keys, size, Order());
+        runs.push_back(keys);
+        run_sizes.push_back(size);
+        keys += size;
+        remaining -= size;
+      }
+    }
+    VQMerge(runs.data(), run_sizes.data(), runs.size(), keys_out, Order());
+    SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, out.get(),
+                                num_keys, num_keys);
+  }
+#else
+  (void)num_keys_a;
+  (void)num_keys_b;
+  (void)num_runs;
+#endif  // VQSORT_ENABLED
+}
+
+// NaN are last for both orders, even though SIMD Min/Max do not order them.
+template <class Order>
+void TestMergeNaN() {
+  const float nan = BitCastScalar<float>(0x7FC00000u);
+  const float kSign = Order::IsAscending() ? 1.0f : -1.0f;
+  std::vector<float> a(40), b(30);
+  for (size_t i = 0; i < a.size(); ++i) a[i] = kSign * static_cast<float>(2 * i);
+  for (size_t i = 0; i < b.size(); ++i) b[i] = kSign * static_cast<float>(3 * i);
+  a[a.size() - 1] = nan;
+  b[b.size() - 2] = nan;
+  b[b.size() - 1] = nan;
+  std::vector<float> out(a.size() + b.size());
+  VQMerge(a.data(), a.size(), b.data(), b.size(), out.data(), Order());
+  for (size_t i = 0; i < out.size() - 3; ++i) {
+    HWY_ASSERT(!ScalarIsNaN(out[i]));
+    if (i != 0) HWY_ASSERT(kSign * out[i - 1] <= kSign * out[i]);
+  }
+  for (size_t i = out.size() - 3; i < out.size(); ++i) {
+    HWY_ASSERT(ScalarIsNaN(out[i]));
+  }
+}
+
+void TestAllMerge() {
+  TestMergeNaN<SortAscending>();
+  TestMergeNaN<SortDescending>();
+
+  const size_t kSizes[][2] = {{0, 5}, {1, 1}, {7, 300}, {1000, 1000},
+                              {3000, 17}, {5000, 9000}};
+  for (const auto& sizes : kSizes) {
+    const size_t num_a = sizes[0];
+    const size_t num_b = sizes[1];
+    for (size_t num_runs : {size_t{1}, size_t{3}, size_t{8}}) {
+      TestAnyMerge<TraitsLane<OrderAscending<int16_t>>>(num_a, num_b,
+                                                        num_runs);
+      TestAnyMerge<TraitsLane<OtherOrder<uint32_t>>>(num_a, num_b, num_runs);
+      TestAnyMerge<TraitsLane<OrderAscending<int64_t>>>(num_a, num_b,
+                                                        num_runs);
+      TestAnyMerge<TraitsLane<OtherOrder<float>>>(num_a, num_b, num_runs);
+#if HWY_HAVE_FLOAT64  // #if protects algo-inl.h's GenerateRandom
+      if (hwy::HaveFloat64()) {
+        TestAnyMerge<TraitsLane<OrderAscending<double>>>(num_a, num_b,
+                                                         num_runs);
+      }
+#endif
+      TestAnyMerge<TraitsLane<OrderDescendingKV64>>(num_a, num_b, num_runs);
+#if HWY_TARGET != HWY_SCALAR
+      TestAnyMerge<Traits128<OrderAscending128>>(num_a, num_b, num_runs);
+      TestAnyMerge<Traits128<OrderDescendingKV128>>(num_a, num_b, num_runs);
+#endif
+    }
+  }
+}
+
+template <typename T>
+void WriteTestFile(const std::string& path, const T* keys, size_t num_keys) {
+  FILE* f = fopen(path.c_str(), "wb");
+  HWY_ASSERT(f);
+  HWY_ASSERT(fwrite(keys, sizeof(T), num_keys, f) == num_keys);
+  HWY_ASSERT(fclose(f) == 0);
+}
+
+// Returns the number of keys read.
+template <typename T>
+size_t ReadTestFile(const std::string& path, T* keys, size_t max_keys) {
+  FILE* f = fopen(path.c_str(), "rb");
+  HWY_ASSERT(f);
+  const size_t num_keys = fread(keys, sizeof(T), max_keys, f);
+  HWY_ASSERT(fclose(f) == 0);
+  return num_keys;
+}
+
+template <class Traits>
+void TestAnyExternalSort(size_t num_keys) {
+#if VQSORT_ENABLED
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  SharedTraits<Traits> st;
+  constexpr size_t kLPK = st.LanesPerKey();
+  const std::string path_in = testing::TempDir() + "external_sort_in";
+  const std::string path_out = testing::TempDir() + "external_sort_out";
+
+  // One extra key so that allocations are nonzero, and to detect excess output.
+  auto in = hwy::AllocateAligned<LaneType>((num_keys + 1) * kLPK);
+  auto out = hwy::AllocateAligned<LaneType>((num_keys + 1) * kLPK);
+  HWY_ASSERT(in && out);
+  InputStats<LaneType> input_stats;
+  (void)GenerateInput(Dist::kUniform32, in.get(), num_keys * kLPK);
+  for (size_t i = 0; i < num_keys * kLPK; ++i) input_stats.Notify(in[i]);
+  WriteTestFile(path_in, HWY_RCAST_ALIGNED(KeyType*, in.get()), num_keys);
+
+  // The minimum budget, so that larger inputs require multiple merge passes.
+  HWY_ASSERT(ExternalSort<KeyType>(path_in.c_str(), path_out.c_str(), 0,
+                                   Order()));
+  HWY_ASSERT(num_keys == ReadTestFile(path_out,
+                                      HWY_RCAST_ALIGNED(KeyType*, out.get()),
+                                      num_keys + 1));
+  if (num_keys != 0) {
+    SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, out.get(),
+                                num_keys, num_keys);
+  }
+  // Temporary files were removed.
+  HWY_ASSERT(fopen((path_out + ".run0").c_str(), "rb") == nullptr);
+  remove(path_in.c_str());
+  remove(path_out.c_str());
+#else
+  (void)num_keys;
+#endif  // VQSORT_ENABLED
+}
+
+void TestAllExternalSort() {
+  const std::string path_in = testing::TempDir() + "external_sort_in";
+  const std::string path_out = testing::TempDir() + "external_sort_out";
+  // Nonexistent input and an incomplete key are errors.
+  remove(path_in.c_str());
+  HWY_ASSERT(!ExternalSort<uint32_t>(path_in.c_str(), path_out.c_str(), 0,
+                                     SortAscending()));
+  const uint16_t odd[3] = {1, 2, 3};
+  WriteTestFile(path_in, odd, 3);
+  HWY_ASSERT(!ExternalSort<uint32_t>(path_in.c_str(), path_out.c_str(), 0,
+                                     SortAscending()));
+  remove(path_in.c_str());
+
+  // The minimum budget is 1 MiB, hence 0.6M u32 are three runs, which
+  // requires two merge passes, and 0.5M u128 are eight runs.
+  for (size_t num_keys : {size_t{0}, size_t{1000}, size_t{600000}}) {
+    TestAnyExternalSort<TraitsLane<OrderAscending<uint32_t>>>(num_keys);
+    TestAnyExternalSort<TraitsLane<OtherOrder<float>>>(num_keys);
+    TestAnyExternalSort<TraitsLane<OrderDescendingKV64>>(num_keys);
+  }
+  TestAnyExternalSort<TraitsLane<OtherOrder<int16_t>>>(1200000);
+#if HWY_TARGET != HWY_SCALAR
+  TestAnyExternalSort<Traits128<OrderAscending128>>(500000);
+#endif
+}
+
+template <class Traits>
+void TestAnySortSegments(size_t max_segment_keys, hwy::ThreadPool& pool) {
+#if VQSORT_ENABLED
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = hwy::If<Traits::Order::IsAscending(), SortAscending,
+                        SortDescending>;
+  SharedTraits<Traits> st;
+  constexpr size_t kLPK = st.LanesPerKey();
+
+  // Segment sizes are random and include empty segments.
+  std::mt19937 rng(static_cast<uint32_t>(max_segment_keys));
+  std::vector<size_t> offsets = {0};
+  for (size_t i = 0; i < 300; ++i) {
+    offsets.push_back(offsets.back() +
+                      static_cast<size_t>(rng()) % (max_segment_keys + 1));
+  }
+  const size_t num_segments = offsets.size() - 1;
+  const size_t num_keys = offsets.back();
+
+  auto in = hwy::AllocateAligned<LaneType>((num_keys + 1) * kLPK);
+  auto out = hwy::AllocateAligned<LaneType>((num_keys + 1) * kLPK);
+  HWY_ASSERT(in && out);
+  KeyType* keys = HWY_RCAST_ALIGNED(KeyType*, out.get());
+  for (Dist dist : AllDist()) {
+    (void)GenerateInput(dist, in.get(), num_keys * kLPK);
+    for (int variant = 0; variant < 3; ++variant) {
+      CopyBytes(in.get(), out.get(), num_keys * sizeof(KeyType));
+      if (variant == 0) {
+        VQSortSegmentsStatic(keys, offsets.data(), num_segments, Order());
+      } else if (variant == 1) {
+        VQSortSegments(keys, offsets.data(), num_segments, Order());
+      } else {
+        VQSortSegments(keys, offsets.data(), num_segments, Order(), pool);
+      }
+
+      for (size_t i = 0; i < num_segments; ++i) {
+        const size_t begin = offsets[i] * kLPK;
+        const size_t num = offsets[i + 1] - offsets[i];
+        if (num == 0) continue;
+        InputStats<LaneType> input_stats;
+        for (size_t j = 0; j < num * kLPK; ++j) {
+          input_stats.Notify(in[begin + j]);
+        }
+        SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats,
+                                    out.get() + begin, num, num);
+      }
+    }
+  }
+#else
+  (void)max_segment_keys;
+  (void)pool;
+#endif  // VQSORT_ENABLED
+}
+
+void TestAllSortSegments() {
+  hwy::ThreadPool pool(hwy::HaveThreadingSupport() ? 4 : 0);
+  // Mostly tiny segments, then also larger than the sorting networks.
+  for (size_t max_segment_keys : {size_t{3}, size_t{40}, size_t{600}}) {
+    TestAnySortSegments<TraitsLane<OrderAscending<int16_t>>>(max_segment_keys,
+                                                             pool);
+    TestAnySortSegments<TraitsLane<OtherOrder<uint32_t>>>(max_segment_keys,
+                                                          pool);
+    TestAnySortSegments<TraitsLane<OrderAscending<int64_t>>>(max_segment_keys,
+                                                             pool);
+    TestAnySortSegments<TraitsLane<OtherOrder<float>>>(max_segment_keys, pool);
+    TestAnySortSegments<TraitsLane<OrderDescendingKV64>>(max_segment_keys,
+                                                         pool);
+#if HWY_TARGET != HWY_SCALAR
+    TestAnySortSegments<Traits128<OrderAscending128>>(max_segment_keys, pool);
+    TestAnySortSegments<Traits128<OrderDescendingKV128>>(max_segment_keys,
+                                                         pool);
+#endif
+  }
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -266,6 +798,13 @@ HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortIota);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllSort);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllSelect);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllPartialSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllParallelSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllRadixSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllArgSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllStableSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllMerge);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllExternalSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortSegments);
 HWY_AFTER_TEST();
 }  // namespace
 }  // namespace hwy
@@ -98,6 +98,7 @@ HWY_INLINE uint64_t* GetGeneratorStateStatic() {
 #endif
 
 #include "hwy/contrib/algo/copy-inl.h"
+#include "hwy/contrib/sort/radix-inl.h"
 #include "hwy/contrib/sort/shared-inl.h"
 #include "hwy/contrib/sort/sorting_networks-inl.h"
 #include "hwy/contrib/sort/traits-inl.h"
@@ -2094,6 +2095,47 @@ void Select(D d, Traits st, T* HWY_RESTRICT keys, const size_t num,
   }
 }
 
+#if VQSORT_ENABLED || HWY_IDE
+
+// Sorts each of the `num_segments` subarrays [offsets[i], offsets[i + 1]) of
+// `keys`, where `offsets` are in units of keys and must be non-decreasing.
+// Segments small enough for BaseCase are sorted by the Sort8Rows/Sort16Rows
+// networks without the setup (random generator state, HandleSpecialCases) of
+// `Sort`. For the others, calls `sort_large(segment, num)`, where `num` is in
+// units of `T`. This is much faster than calling `Sort` per tiny segment.
+template <class D, class Traits, typename T, class SortLarge>
+void SortSegments(D d, Traits st, T* HWY_RESTRICT keys,
+                  const size_t* HWY_RESTRICT offsets, const size_t num_segments,
+                  T* HWY_RESTRICT buf, const SortLarge& sort_large) {
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return SortSegments(CappedTag<T, 64 / sizeof(T)>(), st, keys, offsets,
+                        num_segments, buf, sort_large);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t base_case_num = SortConstants::BaseCaseNumLanes<kLPK>(Lanes(d));
+  for (size_t i = 0; i < num_segments; ++i) {
+    HWY_DASSERT(offsets[i] <= offsets[i + 1]);
+    T* HWY_RESTRICT segment = keys + offsets[i] * kLPK;
+    const size_t num = (offsets[i + 1] - offsets[i]) * kLPK;
+    if (HWY_UNLIKELY(num > base_case_num)) {
+      sort_large(segment, num);
+      continue;
+    }
+
+    const size_t num_nan = detail::CountAndReplaceNaN(d, st, segment, num);
+    detail::BaseCase(d, st, segment, num, buf);
+    if (num_nan != 0) {
+      Fill(d, GetLane(NaN(d)), num_nan, segment + num - num_nan);
+    }
+  }
+}
+
+#endif  // VQSORT_ENABLED
+
 // Sorts `keys[0..num-1]` according to the order defined by `st.Compare`.
 // In-place i.e. O(1) additional storage. Worst-case N*logN comparisons.
 // Non-stable (order of equal keys may change), except for the common case where
@@ -2188,8 +2230,11 @@ using MakeTraits =
 // for all functions above this point, they are in units of `T`. Order is either
 // SortAscending or SortDescending.
 template <typename Key, class Order>
-void VQSortStatic(Key* HWY_RESTRICT keys, const size_t num_keys, Order) {
+void VQSortStatic(Key* HWY_RESTRICT keys, const size_t num_keys, Order order) {
 #if VQSORT_ENABLED
+  // For many 16-bit keys, or 32-bit keys within a narrow range.
+  if (detail::MaybeRadixSort(keys, num_keys, order)) return;
+
   const detail::MakeTraits<Key, Order> st;
   using LaneType = typename decltype(st)::LaneType;
   const SortTag<LaneType> d;
@@ -2197,6 +2242,29 @@ void VQSortStatic(Key* HWY_RESTRICT keys, const size_t num_keys, Order) {
 #else
   (void)keys;
   (void)num_keys;
+  (void)order;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// Like VQSortStatic, but always uses counting sort or LSD radix sort, which
+// allocates a copy of the keys if their range exceeds 2^16. Only for 16 and
+// 32-bit keys, i.e. not K32V32 nor 128-bit keys. Falls back to quicksort if
+// allocation fails.
+template <typename Key, class Order>
+void VQRadixSortStatic(Key* HWY_RESTRICT keys, const size_t num_keys,
+                       Order order) {
+#if VQSORT_ENABLED
+  if (detail::RadixSort(keys, num_keys, order)) return;
+
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  Sort(d, st, reinterpret_cast<LaneType*>(keys), num_keys);
+#else
+  (void)keys;
+  (void)num_keys;
+  (void)order;
   HWY_ASSERT(0);
 #endif  // VQSORT_ENABLED
 }
@@ -2235,6 +2303,34 @@ void VQSelectStatic(Key* HWY_RESTRICT keys, const size_t num_keys,
 #endif  // VQSORT_ENABLED
 }
 
+// Sorts each segment [offsets[i], offsets[i + 1]) of `keys` for `i` in
+// [0, num_segments), hence `offsets` has `num_segments + 1` entries. Segments
+// that fit in the sorting networks are sorted without the per-call overhead of
+// VQSortStatic, which is used for the others.
+template <typename Key, class Order>
+void VQSortSegmentsStatic(Key* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          const size_t num_segments, Order) {
+#if VQSORT_ENABLED
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  constexpr size_t kLPK = st.LanesPerKey();
+  HWY_ALIGN LaneType buf[SortConstants::BufBytes<LaneType, kLPK>(
+                             HWY_MAX_BYTES) /
+                         sizeof(LaneType)];
+  SortSegments(d, st, reinterpret_cast<LaneType*>(keys), offsets, num_segments,
+               buf, [&](LaneType* HWY_RESTRICT segment, size_t num) {
+                 Sort(d, st, segment, num, buf);
+               });
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -36,10 +36,15 @@
 
 namespace hwy {
 
+class ThreadPool;  // for the parallel VQSort overloads
+
 // Vectorized Quicksort: sorts keys[0, n). Does not preserve the ordering of
 // equivalent keys (defined as: neither greater nor less than another).
-// Dispatches to the best available instruction set. Does not allocate memory.
-// Uses about 1.2 KiB stack plus an internal 3-word TLS cache for random state.
+// Dispatches to the best available instruction set. Uses about 1.2 KiB stack
+// plus an internal 3-word TLS cache for random state. Does not allocate memory,
+// except that for at least 4096 16-bit keys, or 32-bit keys whose range is
+// small relative to their number, it may instead use a counting sort with a
+// histogram of up to 256 KiB. See also VQRadixSort.
 HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
                                   SortAscending);
 HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
@@ -222,6 +227,720 @@ HWY_CONTRIB_DLLEXPORT void VQSelect(K64V64* HWY_RESTRICT keys, size_t n,
 HWY_CONTRIB_DLLEXPORT void VQSelect(K64V64* HWY_RESTRICT keys, size_t n,
                                     size_t k, SortDescending);
 
+// Parallel Vectorized Quicksort: sorts keys[0, n) like VQSort, but using all
+// workers of `pool`. Samples the keys to choose splitters, distributes the keys
+// into the resulting buckets, and then calls VQSort for each bucket via
+// `pool.Run`, whose work stealing balances the load. Unlike VQSort, this
+// allocates a copy of the keys plus a 16-bit bucket index per key. Falls back
+// to VQSort if `n` is too small, `pool` has only one worker, or the allocation
+// fails. Must not be called concurrently with any other `pool.Run`.
+HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSort(double* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(double* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// 128-bit types: `n` is still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// Vectorized argsort: writes to indices[0, n) the permutation that sorts
+// keys[0, n), i.e. keys[indices[i]] is the i-th key in sorted order. `keys` are
+// not modified. Unlike VQSort, equivalent keys are ordered by their index,
+// i.e. this is stable. Internally sorts (key, index) pairs packed into a
+// temporary u64 or u128 array, hence allocates 8 or 16 bytes per key. With
+// 32-bit `indices`, `n` must be at most 2^32.
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+// These must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+// These must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K32V32* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K32V32* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K32V32* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K32V32* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+// 128-bit types: `n` is still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint128_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint128_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint128_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint128_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K64V64* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K64V64* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K64V64* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const K64V64* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+// Stable sort: like VQSort, but equivalent keys retain their input order. This
+// matters for K32V32/K64V64, whose values are not compared, and for -0/+0 and
+// NaN with differing payloads. Other keys are only equivalent if identical, so
+// this is VQSort for those. Otherwise sorts (key, index) pairs as in VQArgSort,
+// then gathers the keys. Allocates 8 or 16 bytes per key for the pairs plus a
+// copy of `keys`.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+// These must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQStableSort(float* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(float* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+// These must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(double* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(double* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+// 128-bit types: `n` is still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+// Radix sort: same result as VQSort, but always uses counting sort if the range
+// of the keys is at most 2^16, and otherwise an LSD radix sort with up to four
+// passes of at most 10 bits. The latter allocates a copy of the keys. This is
+// usually faster than VQSort for large `n`, in particular if the range is
+// narrow, but VQSort only chooses counting sort automatically. Only available
+// for 16 and 32-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+// These must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+// Vectorized merge: writes to out[0, num_a + num_b) the union of a[0, num_a)
+// and b[0, num_b), which must each be sorted in the given order, for example by
+// VQSort. `out` must not overlap the inputs. Uses bitonic merging networks on
+// pairs of vectors. Equivalent keys are not necessarily ordered by their input.
+// Does not allocate memory.
+//
+// The second overload merges `num_runs` sorted runs, where `runs[i]` has
+// `run_sizes[i]` keys, into `out`, whose size is the sum of `run_sizes`. This
+// is a tree of 2-way merges, which moves each key ceil(log2(num_runs)) times
+// and allocates a buffer of that size if `num_runs` > 2.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint16_t* HWY_RESTRICT b, size_t num_b,
+                                   uint16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint16_t* HWY_RESTRICT b, size_t num_b,
+                                   uint16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint16_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint16_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint32_t* HWY_RESTRICT b, size_t num_b,
+                                   uint32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint32_t* HWY_RESTRICT b, size_t num_b,
+                                   uint32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint32_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint32_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint64_t* HWY_RESTRICT b, size_t num_b,
+                                   uint64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint64_t* HWY_RESTRICT b, size_t num_b,
+                                   uint64_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint64_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint64_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* HWY_RESTRICT a, size_t num_a,
+                                   const int16_t* HWY_RESTRICT b, size_t num_b,
+                                   int16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* HWY_RESTRICT a, size_t num_a,
+                                   const int16_t* HWY_RESTRICT b, size_t num_b,
+                                   int16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, int16_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, int16_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* HWY_RESTRICT a, size_t num_a,
+                                   const int32_t* HWY_RESTRICT b, size_t num_b,
+                                   int32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* HWY_RESTRICT a, size_t num_a,
+                                   const int32_t* HWY_RESTRICT b, size_t num_b,
+                                   int32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, int32_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, int32_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* HWY_RESTRICT a, size_t num_a,
+                                   const int64_t* HWY_RESTRICT b, size_t num_b,
+                                   int64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* HWY_RESTRICT a, size_t num_a,
+                                   const int64_t* HWY_RESTRICT b, size_t num_b,
+                                   int64_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, int64_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, int64_t* HWY_RESTRICT out,
+                                   SortDescending);
+
+// These must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const float16_t* HWY_RESTRICT b,
+                                   size_t num_b,
+                                   float16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const float16_t* HWY_RESTRICT b,
+                                   size_t num_b,
+                                   float16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, float16_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, float16_t* HWY_RESTRICT out,
+                                   SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* HWY_RESTRICT a, size_t num_a,
+                                   const float* HWY_RESTRICT b, size_t num_b,
+                                   float* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* HWY_RESTRICT a, size_t num_a,
+                                   const float* HWY_RESTRICT b, size_t num_b,
+                                   float* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, float* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, float* HWY_RESTRICT out,
+                                   SortDescending);
+
+// These must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* HWY_RESTRICT a, size_t num_a,
+                                   const double* HWY_RESTRICT b, size_t num_b,
+                                   double* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* HWY_RESTRICT a, size_t num_a,
+                                   const double* HWY_RESTRICT b, size_t num_b,
+                                   double* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, double* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, double* HWY_RESTRICT out,
+                                   SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* HWY_RESTRICT a, size_t num_a,
+                                   const K32V32* HWY_RESTRICT b, size_t num_b,
+                                   K32V32* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* HWY_RESTRICT a, size_t num_a,
+                                   const K32V32* HWY_RESTRICT b, size_t num_b,
+                                   K32V32* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, K32V32* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, K32V32* HWY_RESTRICT out,
+                                   SortDescending);
+
+// 128-bit types: `num_*` and `run_sizes` are in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const uint128_t* HWY_RESTRICT b,
+                                   size_t num_b,
+                                   uint128_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const uint128_t* HWY_RESTRICT b,
+                                   size_t num_b,
+                                   uint128_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint128_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, uint128_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* HWY_RESTRICT a, size_t num_a,
+                                   const K64V64* HWY_RESTRICT b, size_t num_b,
+                                   K64V64* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* HWY_RESTRICT a, size_t num_a,
+                                   const K64V64* HWY_RESTRICT b, size_t num_b,
+                                   K64V64* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, K64V64* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* const* HWY_RESTRICT runs,
+                                   const size_t* HWY_RESTRICT run_sizes,
+                                   size_t num_runs, K64V64* HWY_RESTRICT out,
+                                   SortDescending);
+
+// External (out-of-core) sort for inputs larger than memory: reads the keys
+// stored in native layout in the file `path_in` and writes them, sorted
+// according to `Order`, to `path_out`, which must differ from `path_in`. Uses
+// about `memory_budget` bytes (at least 1 MiB) of memory. Sorts chunks of that
+// size with VQSort into runs, written to temporary files named `path_out` plus
+// a ".run" suffix, and then merges them with VQMerge and large sequential I/O.
+// Returns false if a file could not be read or written, or the size of
+// `path_in` is not a multiple of the key size. Instantiated for the key types
+// of VQSort; float16_t and double also have the same requirements as VQSort.
+template <typename T, class Order>
+HWY_CONTRIB_DLLEXPORT bool ExternalSort(const char* path_in,
+                                        const char* path_out,
+                                        size_t memory_budget, Order order);
+
+// Segmented sort: for each `i` in [0, num_segments), sorts the keys in
+// [offsets[i], offsets[i + 1]) like VQSort, hence `offsets` has
+// `num_segments + 1` non-decreasing entries. Intended for many small segments,
+// for which the per-call overhead of VQSort would dominate: this dispatches
+// only once, and segments that fit in the sorting networks (8 to 256 keys,
+// depending on the key and vector size) are sorted without further setup. The
+// others are passed to VQSort. The overloads with a `pool` distribute ranges of
+// segments with about the same total size across its workers.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
+// These must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
+// These must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
+// 128-bit types: `offsets` are still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
 // User-level caching is no longer required, so this class is no longer
 // beneficial. We recommend using the simpler VQSort() interface instead, and
 // retain this class only for compatibility. It now just calls VQSort.
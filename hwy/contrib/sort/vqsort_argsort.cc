@@ -0,0 +1,291 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Argsort and stable sort via the dynamic-dispatch VQSort of (key, index)
+// pairs. Keys are converted to unsigned integers whose ascending order matches
+// the requested order, so that each pair can be sorted as a single u64 or u128
+// key. Because the index is the least-significant part, ties are ordered by
+// index.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"
+
+namespace hwy {
+namespace {
+
+template <typename TU>
+HWY_INLINE TU ApplyOrder(TU bits, SortAscending) {
+  return bits;
+}
+template <typename TU>
+HWY_INLINE TU ApplyOrder(TU bits, SortDescending) {
+  return static_cast<TU>(~bits);
+}
+
+// Returns unsigned bits whose ascending order is the `Order` of `key`.
+template <class Order>
+HWY_INLINE uint16_t SortableBits(uint16_t key, Order order) {
+  return ApplyOrder(key, order);
+}
+template <class Order>
+HWY_INLINE uint32_t SortableBits(uint32_t key, Order order) {
+  return ApplyOrder(key, order);
+}
+template <class Order>
+HWY_INLINE uint64_t SortableBits(uint64_t key, Order order) {
+  return ApplyOrder(key, order);
+}
+
+template <typename TI, class Order>
+HWY_INLINE MakeUnsigned<TI> SignedSortableBits(TI key, Order order) {
+  using TU = MakeUnsigned<TI>;
+  const TU bits = static_cast<TU>(BitCastScalar<TU>(key) ^ SignMask<TU>());
+  return ApplyOrder(bits, order);
+}
+template <class Order>
+HWY_INLINE uint16_t SortableBits(int16_t key, Order order) {
+  return SignedSortableBits(key, order);
+}
+template <class Order>
+HWY_INLINE uint32_t SortableBits(int32_t key, Order order) {
+  return SignedSortableBits(key, order);
+}
+template <class Order>
+HWY_INLINE uint64_t SortableBits(int64_t key, Order order) {
+  return SignedSortableBits(key, order);
+}
+
+// Like VQSort, NaN are last for both orders, and -0 and +0 are equivalent.
+template <typename TF, class Order>
+HWY_INLINE MakeUnsigned<TF> FloatSortableBits(TF key, Order order) {
+  using TU = MakeUnsigned<TF>;
+  if (HWY_UNLIKELY(ScalarIsNaN(key))) return LimitsMax<TU>();
+  const TU sign = SignMask<TU>();
+  TU bits = BitCastScalar<TU>(key);
+  if ((bits & static_cast<TU>(~sign)) == 0) {
+    bits = sign;  // either zero
+  } else {
+    bits = (bits & sign) ? static_cast<TU>(~bits) : static_cast<TU>(bits | sign);
+  }
+  // No non-NaN maps to all-ones in either order because infinity has a zero
+  // mantissa.
+  return ApplyOrder(bits, order);
+}
+template <class Order>
+HWY_INLINE uint16_t SortableBits(float16_t key, Order order) {
+  return FloatSortableBits(key, order);
+}
+template <class Order>
+HWY_INLINE uint32_t SortableBits(float key, Order order) {
+  return FloatSortableBits(key, order);
+}
+template <class Order>
+HWY_INLINE uint64_t SortableBits(double key, Order order) {
+  return FloatSortableBits(key, order);
+}
+
+// Only the key is compared, as in VQSort.
+template <class Order>
+HWY_INLINE uint32_t SortableBits(const K32V32& key, Order order) {
+  return ApplyOrder(key.key, order);
+}
+template <class Order>
+HWY_INLINE uint64_t SortableBits(const K64V64& key, Order order) {
+  return ApplyOrder(key.key, order);
+}
+
+// (key, index) pairs fit in a single u64 if both are 32 bits or less.
+HWY_INLINE void Pack(uint64_t bits, uint64_t index, uint64_t& packed) {
+  packed = (bits << 32) | index;
+}
+HWY_INLINE void Pack(uint64_t bits, uint64_t index, uint128_t& packed) {
+  packed.hi = bits;
+  packed.lo = index;
+}
+HWY_INLINE uint64_t IndexOf(uint64_t packed) { return packed & 0xFFFFFFFFu; }
+HWY_INLINE uint64_t IndexOf(const uint128_t& packed) { return packed.lo; }
+
+template <typename Index>
+HWY_INLINE void CheckNumKeys(size_t n) {
+  if (sizeof(Index) < sizeof(size_t) &&
+      static_cast<uint64_t>(n) > uint64_t{LimitsMax<Index>()} + 1) {
+    HWY_ABORT("VQArgSort: %zu keys do not fit in %zu-byte indices.", n,
+              sizeof(Index));
+  }
+}
+
+// Calls `func(i, index)` for each `i` in [0, n), where keys[index] is the i-th
+// key in sorted order. `n` must be at most one plus the largest `Index`.
+template <typename Index, typename Key, class Order, class Func>
+void ForEachSorted(const Key* HWY_RESTRICT keys, size_t n, Order order,
+                   const Func& func) {
+  using Bits = decltype(SortableBits(keys[0], order));
+  using Packed = If<sizeof(Bits) <= 4 && sizeof(Index) <= 4, uint64_t,
+                    uint128_t>;
+  AlignedFreeUniquePtr<Packed[]> packed = AllocateAligned<Packed>(n);
+  if (HWY_UNLIKELY(!packed)) {
+    HWY_ABORT("VQSort: failed to allocate %zu (key, index) pairs.", n);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    Pack(SortableBits(keys[i], order), i, packed[i]);
+  }
+  VQSort(packed.get(), n, SortAscending());
+  for (size_t i = 0; i < n; ++i) {
+    func(i, IndexOf(packed[i]));
+  }
+}
+
+// 128-bit keys plus index do not fit in a u128. Sort by the upper half, then
+// sort each run of equal upper halves by the lower half. Runs are usually
+// short, so the second pass is cheap.
+template <typename Index, class Order, class Func>
+void ForEachSorted(const uint128_t* HWY_RESTRICT keys, size_t n, Order order,
+                   const Func& func) {
+  AlignedFreeUniquePtr<uint128_t[]> packed = AllocateAligned<uint128_t>(n);
+  if (HWY_UNLIKELY(!packed)) {
+    HWY_ABORT("VQSort: failed to allocate %zu (key, index) pairs.", n);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    Pack(SortableBits(keys[i].hi, order), i, packed[i]);
+  }
+  VQSort(packed.get(), n, SortAscending());
+
+  size_t begin = 0;
+  while (begin < n) {
+    const uint64_t hi = packed[begin].hi;
+    size_t end = begin + 1;
+    while (end < n && packed[end].hi == hi) ++end;
+    if (end - begin > 1) {
+      for (size_t i = begin; i < end; ++i) {
+        const uint64_t index = packed[i].lo;
+        Pack(SortableBits(keys[index].lo, order), index, packed[i]);
+      }
+      VQSort(packed.get() + begin, end - begin, SortAscending());
+    }
+    begin = end;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    func(i, packed[i].lo);
+  }
+}
+
+template <typename Key, typename Index, class Order>
+void ArgSort(const Key* HWY_RESTRICT keys, size_t n, Index* HWY_RESTRICT indices,
+             Order order) {
+  CheckNumKeys<Index>(n);
+  if (n == 0) return;
+  ForEachSorted<Index>(keys, n, order, [indices](size_t i, uint64_t index) {
+    indices[i] = static_cast<Index>(index);
+  });
+}
+
+// Whether equivalent keys are also identical, in which case any sort is
+// stable. Not true for floats (-0 and +0, NaN payloads) nor key-value pairs.
+template <typename Key>
+constexpr bool EquivalentAreIdentical() {
+  return IsInteger<Key>() || IsSame<Key, uint128_t>();
+}
+
+template <typename Key, class Order>
+void StableSort(Key* HWY_RESTRICT keys, size_t n, Order order) {
+  if (EquivalentAreIdentical<Key>()) return VQSort(keys, n, order);
+  if (n <= 1) return;
+  AlignedFreeUniquePtr<Key[]> copy = AllocateAligned<Key>(n);
+  if (HWY_UNLIKELY(!copy)) {
+    HWY_ABORT("VQStableSort: failed to allocate %zu keys.", n);
+  }
+  CopyBytes(keys, copy.get(), n * sizeof(Key));
+
+  const Key* HWY_RESTRICT from = copy.get();
+  const auto gather = [keys, from](size_t i, uint64_t index) {
+    keys[i] = from[index];
+  };
+  // 32-bit indices allow packing (key, index) into u64 for keys of up to 32
+  // bits, which halves the size of the pairs to sort.
+  if (static_cast<uint64_t>(n) <= uint64_t{LimitsMax<uint32_t>()} + 1) {
+    ForEachSorted<uint32_t>(from, n, order, gather);
+  } else {
+    ForEachSorted<uint64_t>(from, n, order, gather);
+  }
+}
+
+}  // namespace
+
+// clang-format off
+#define HWY_ARGSORT_DEFINE(KEY)                                              \
+  void VQArgSort(const KEY* HWY_RESTRICT keys, size_t n,                     \
+                 uint32_t* HWY_RESTRICT indices, SortAscending tag) {        \
+    ArgSort(keys, n, indices, tag);                                          \
+  }                                                                          \
+  void VQArgSort(const KEY* HWY_RESTRICT keys, size_t n,                     \
+                 uint32_t* HWY_RESTRICT indices, SortDescending tag) {       \
+    ArgSort(keys, n, indices, tag);                                          \
+  }                                                                          \
+  void VQArgSort(const KEY* HWY_RESTRICT keys, size_t n,                     \
+                 uint64_t* HWY_RESTRICT indices, SortAscending tag) {        \
+    ArgSort(keys, n, indices, tag);                                          \
+  }                                                                          \
+  void VQArgSort(const KEY* HWY_RESTRICT keys, size_t n,                     \
+                 uint64_t* HWY_RESTRICT indices, SortDescending tag) {       \
+    ArgSort(keys, n, indices, tag);                                          \
+  }
+
+#define HWY_STABLE_SORT_DEFINE(KEY)                                          \
+  void VQStableSort(KEY* HWY_RESTRICT keys, size_t n, SortAscending tag) {   \
+    StableSort(keys, n, tag);                                                \
+  }                                                                          \
+  void VQStableSort(KEY* HWY_RESTRICT keys, size_t n, SortDescending tag) {  \
+    StableSort(keys, n, tag);                                                \
+  }
+// clang-format on
+
+HWY_ARGSORT_DEFINE(uint16_t)
+HWY_ARGSORT_DEFINE(uint32_t)
+HWY_ARGSORT_DEFINE(uint64_t)
+HWY_ARGSORT_DEFINE(int16_t)
+HWY_ARGSORT_DEFINE(int32_t)
+HWY_ARGSORT_DEFINE(int64_t)
+HWY_ARGSORT_DEFINE(float16_t)
+HWY_ARGSORT_DEFINE(float)
+HWY_ARGSORT_DEFINE(double)
+HWY_ARGSORT_DEFINE(K32V32)
+HWY_ARGSORT_DEFINE(uint128_t)
+HWY_ARGSORT_DEFINE(K64V64)
+
+#undef HWY_ARGSORT_DEFINE
+
+HWY_STABLE_SORT_DEFINE(uint16_t)
+HWY_STABLE_SORT_DEFINE(uint32_t)
+HWY_STABLE_SORT_DEFINE(uint64_t)
+HWY_STABLE_SORT_DEFINE(int16_t)
+HWY_STABLE_SORT_DEFINE(int32_t)
+HWY_STABLE_SORT_DEFINE(int64_t)
+HWY_STABLE_SORT_DEFINE(float16_t)
+HWY_STABLE_SORT_DEFINE(float)
+HWY_STABLE_SORT_DEFINE(double)
+HWY_STABLE_SORT_DEFINE(K32V32)
+HWY_STABLE_SORT_DEFINE(uint128_t)
+HWY_STABLE_SORT_DEFINE(K64V64)
+
+#undef HWY_STABLE_SORT_DEFINE
+
+}  // namespace hwy
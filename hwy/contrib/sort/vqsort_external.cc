@@ -0,0 +1,315 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// External (out-of-core) sort via the dynamic-dispatch VQSort and VQMerge.
+// First sorts budget-sized chunks of the input into runs, each written to a
+// temporary file next to the output. Then merges up to `fan_in` runs at a time
+// until one remains. Each merge round emits, from every run's buffer, the
+// prefix that cannot be preceded by any key not yet read, which is then merged
+// in memory by VQMerge. All reads and writes are large and sequential.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>  // memmove
+
+#include <algorithm>  // std::upper_bound
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"
+
+namespace hwy {
+namespace {
+
+// Lower bound on the memory budget, also used for tiny inputs.
+constexpr size_t kMinBudgetBytes = size_t{1} << 20;
+// Preferred minimum size of reads from each run during merging.
+constexpr size_t kMinReadBytes = size_t{256} << 10;
+
+struct FileCloser {
+  void operator()(FILE* f) const { fclose(f); }
+};
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+FilePtr OpenFile(const std::string& path, const char* mode) {
+  FilePtr f(fopen(path.c_str(), mode));
+  if (!f) HWY_WARN("ExternalSort: failed to open %s.", path.c_str());
+  return f;
+}
+
+// Closes `f` and returns whether all prior writes succeeded.
+bool CloseWritten(FilePtr f, const std::string& path) {
+  if (fclose(f.release()) != 0) {
+    HWY_WARN("ExternalSort: failed to write %s.", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool AtEnd(FILE* f) {
+  const int c = getc(f);
+  if (c == EOF) return true;
+  ungetc(c, f);
+  return false;
+}
+
+// Reads up to `max_keys` into `keys`, sets `num_keys` to the number read and
+// `at_end` if there are no more. Returns false on error, including a size that
+// is not a multiple of the key size.
+template <typename T>
+bool ReadKeys(FILE* f, const std::string& path, T* HWY_RESTRICT keys,
+              size_t max_keys, size_t& num_keys, bool& at_end) {
+  const size_t bytes = fread(keys, 1, max_keys * sizeof(T), f);
+  if (ferror(f) || bytes % sizeof(T) != 0) {
+    HWY_WARN("ExternalSort: failed to read whole keys from %s.", path.c_str());
+    return false;
+  }
+  num_keys = bytes / sizeof(T);
+  at_end = num_keys < max_keys || AtEnd(f);
+  return true;
+}
+
+template <typename T>
+bool WriteKeys(FILE* f, const std::string& path, const T* HWY_RESTRICT keys,
+               size_t num_keys) {
+  if (fwrite(keys, sizeof(T), num_keys, f) != num_keys) {
+    HWY_WARN("ExternalSort: failed to write %s.", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Scalar version of the order used by VQSort: NaN are last in both orders.
+template <typename T>
+bool IsNaNKey(T) {
+  return false;
+}
+bool IsNaNKey(float16_t key) { return ScalarIsNaN(key); }
+bool IsNaNKey(float key) { return ScalarIsNaN(key); }
+bool IsNaNKey(double key) { return ScalarIsNaN(key); }
+
+template <typename T>
+bool KeyBefore(const T& a, const T& b, SortAscending) {
+  if (IsNaNKey(a)) return false;
+  return IsNaNKey(b) || a < b;
+}
+template <typename T>
+bool KeyBefore(const T& a, const T& b, SortDescending) {
+  if (IsNaNKey(a)) return false;
+  return IsNaNKey(b) || b < a;
+}
+
+class ExternalSorter {
+ public:
+  ExternalSorter(const char* path_out, size_t memory_budget)
+      : path_out_(path_out),
+        budget_bytes_(HWY_MAX(memory_budget, kMinBudgetBytes)) {}
+
+  // Removes any temporary files that remain after a failure.
+  ~ExternalSorter() {
+    for (const std::string& path : runs_) remove(path.c_str());
+  }
+
+  template <typename T, class Order>
+  bool Sort(const char* path_in, Order order) {
+    if (!SortChunks<T>(path_in, order)) return false;
+    // SortChunks already wrote the output if there was at most one chunk.
+    if (runs_.empty()) return true;
+
+    // Each merge round requires `num_runs` input buffers, an output buffer
+    // of the same total size, and VQMerge allocates another.
+    const size_t round_keys = budget_bytes_ / 3 / sizeof(T);
+    const size_t min_read_keys = HWY_MAX(kMinReadBytes / sizeof(T), size_t{1});
+    const size_t fan_in = HWY_MAX(round_keys / min_read_keys, size_t{2});
+
+    while (runs_.size() > 1) {
+      std::vector<std::string> merged;
+      for (size_t first = 0; first < runs_.size(); first += fan_in) {
+        const size_t num_runs = HWY_MIN(fan_in, runs_.size() - first);
+        if (num_runs == 1) {  // Leftover; merge it in the next pass.
+          merged.push_back(runs_[first]);
+          continue;
+        }
+        const bool is_final = num_runs == runs_.size();
+        const std::string path = is_final ? path_out_ : NewTempPath();
+        if (!is_final) merged.push_back(path);
+        if (!MergeRuns<T>(&runs_[first], num_runs, round_keys / num_runs,
+                          path, order)) {
+          runs_.insert(runs_.end(), merged.begin(), merged.end());
+          return false;
+        }
+        for (size_t i = 0; i < num_runs; ++i) remove(runs_[first + i].c_str());
+      }
+      runs_.swap(merged);
+    }
+    return true;
+  }
+
+ private:
+  std::string NewTempPath() {
+    return path_out_ + ".run" + std::to_string(num_temp_++);
+  }
+
+  // Writes sorted chunks of the input to runs_, or directly to the output if
+  // the input fits in the budget.
+  template <typename T, class Order>
+  bool SortChunks(const char* path_in, Order order) {
+    FilePtr in = OpenFile(path_in, "rb");
+    if (!in) return false;
+
+    const size_t chunk_keys = budget_bytes_ / sizeof(T);
+    AlignedFreeUniquePtr<T[]> chunk = AllocateAligned<T>(chunk_keys);
+    HWY_ASSERT(chunk);
+
+    for (;;) {
+      size_t num_keys;
+      bool at_end;
+      if (!ReadKeys(in.get(), path_in, chunk.get(), chunk_keys, num_keys,
+                    at_end)) {
+        return false;
+      }
+      VQSort(chunk.get(), num_keys, order);
+
+      const bool is_only = runs_.empty() && at_end;
+      const std::string path = is_only ? path_out_ : NewTempPath();
+      if (!is_only) runs_.push_back(path);
+      FilePtr out = OpenFile(path, "wb");
+      if (!out) return false;
+      if (!WriteKeys(out.get(), path, chunk.get(), num_keys)) return false;
+      if (!CloseWritten(std::move(out), path)) return false;
+      if (at_end) return true;
+    }
+  }
+
+  // Merges the sorted runs in paths[0, num_runs) into `path_out`, reading
+  // `buf_keys` at a time from each.
+  template <typename T, class Order>
+  bool MergeRuns(const std::string* paths, size_t num_runs, size_t buf_keys,
+                 const std::string& path_out, Order order) {
+    HWY_DASSERT(num_runs >= 2 && buf_keys != 0);
+    std::vector<FilePtr> files(num_runs);
+    for (size_t i = 0; i < num_runs; ++i) {
+      files[i] = OpenFile(paths[i], "rb");
+      if (!files[i]) return false;
+    }
+    FilePtr out = OpenFile(path_out, "wb");
+    if (!out) return false;
+
+    AlignedFreeUniquePtr<T[]> in_keys = AllocateAligned<T>(num_runs * buf_keys);
+    AlignedFreeUniquePtr<T[]> out_keys =
+        AllocateAligned<T>(num_runs * buf_keys);
+    HWY_ASSERT(in_keys && out_keys);
+    // Per run: [begin, end) of the keys in its buffer not yet merged, and
+    // whether the file has more.
+    std::vector<size_t> begin(num_runs, 0);
+    std::vector<size_t> end(num_runs, 0);
+    std::vector<bool> more(num_runs, true);
+    std::vector<const T*> prefix(num_runs);
+    std::vector<size_t> prefix_size(num_runs);
+
+    for (;;) {
+      // Refill buffers, moving any remainder to the front.
+      for (size_t i = 0; i < num_runs; ++i) {
+        if (!more[i] || end[i] - begin[i] == buf_keys) continue;
+        T* buf = in_keys.get() + i * buf_keys;
+        const size_t remaining = end[i] - begin[i];
+        if (remaining != 0) {
+          memmove(buf, buf + begin[i], remaining * sizeof(T));
+        }
+        size_t num_read;
+        bool at_end;
+        if (!ReadKeys(files[i].get(), paths[i], buf + remaining,
+                      buf_keys - remaining, num_read, at_end)) {
+          return false;
+        }
+        begin[i] = 0;
+        end[i] = remaining + num_read;
+        more[i] = !at_end;
+      }
+      // No run may emit keys after the first of its unread keys, which are
+      // not before the last key in its buffer.
+      const T* bound = nullptr;
+      for (size_t i = 0; i < num_runs; ++i) {
+        if (!more[i]) continue;
+        const T* last = in_keys.get() + i * buf_keys + end[i] - 1;
+        if (!bound || KeyBefore(*last, *bound, order)) bound = last;
+      }
+
+      size_t num_out = 0;
+      for (size_t i = 0; i < num_runs; ++i) {
+        const T* first = in_keys.get() + i * buf_keys + begin[i];
+        const T* last = in_keys.get() + i * buf_keys + end[i];
+        if (bound) {
+          last = std::upper_bound(first, last, *bound,
+                                  [order](const T& a, const T& b) {
+                                    return KeyBefore(a, b, order);
+                                  });
+        }
+        prefix[i] = first;
+        prefix_size[i] = static_cast<size_t>(last - first);
+        num_out += prefix_size[i];
+      }
+      if (num_out != 0) {
+        VQMerge(prefix.data(), prefix_size.data(), num_runs, out_keys.get(),
+                order);
+        if (!WriteKeys(out.get(), path_out, out_keys.get(), num_out)) {
+          return false;
+        }
+      }
+      for (size_t i = 0; i < num_runs; ++i) begin[i] += prefix_size[i];
+      if (!bound) break;  // all runs were read and have now been merged
+    }
+    return CloseWritten(std::move(out), path_out);
+  }
+
+  const std::string path_out_;
+  const size_t budget_bytes_;
+  size_t num_temp_ = 0;
+  std::vector<std::string> runs_;  // temporary files holding sorted runs
+};
+
+}  // namespace
+
+template <typename T, class Order>
+bool ExternalSort(const char* path_in, const char* path_out,
+                  size_t memory_budget, Order order) {
+  ExternalSorter sorter(path_out, memory_budget);
+  return sorter.Sort<T>(path_in, order);
+}
+
+#define HWY_EXTERNAL_SORT_INSTANTIATE(KEY)                                    \
+  template bool ExternalSort<KEY, SortAscending>(const char*, const char*,    \
+                                                 size_t, SortAscending);      \
+  template bool ExternalSort<KEY, SortDescending>(const char*, const char*,   \
+                                                  size_t, SortDescending);
+HWY_EXTERNAL_SORT_INSTANTIATE(uint16_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(uint32_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(uint64_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(int16_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(int32_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(int64_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(float16_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(float)
+HWY_EXTERNAL_SORT_INSTANTIATE(double)
+HWY_EXTERNAL_SORT_INSTANTIATE(K32V32)
+HWY_EXTERNAL_SORT_INSTANTIATE(uint128_t)
+HWY_EXTERNAL_SORT_INSTANTIATE(K64V64)
+#undef HWY_EXTERNAL_SORT_INSTANTIATE
+
+}  // namespace hwy
@@ -0,0 +1,167 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/contrib/sort/vqsort.h"  // VQMerge
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_merge.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/merge-inl.h"
+
+// The merge is much less code than the sort, hence all key types share one
+// translation unit. NAME is the suffix of the per-target function, and
+// ENABLED whether the current target supports the key type.
+#define HWY_MERGE_FOREACH_KEY(X)                                               \
+  X(uint16_t, U16Asc, SortAscending, 1)                                        \
+  X(uint16_t, U16Desc, SortDescending, 1)                                      \
+  X(uint32_t, U32Asc, SortAscending, 1)                                        \
+  X(uint32_t, U32Desc, SortDescending, 1)                                      \
+  X(uint64_t, U64Asc, SortAscending, 1)                                        \
+  X(uint64_t, U64Desc, SortDescending, 1)                                      \
+  X(int16_t, I16Asc, SortAscending, 1)                                         \
+  X(int16_t, I16Desc, SortDescending, 1)                                       \
+  X(int32_t, I32Asc, SortAscending, 1)                                         \
+  X(int32_t, I32Desc, SortDescending, 1)                                       \
+  X(int64_t, I64Asc, SortAscending, 1)                                         \
+  X(int64_t, I64Desc, SortDescending, 1)                                       \
+  X(float16_t, F16Asc, SortAscending, HWY_HAVE_FLOAT16)                        \
+  X(float16_t, F16Desc, SortDescending, HWY_HAVE_FLOAT16)                      \
+  X(float, F32Asc, SortAscending, 1)                                           \
+  X(float, F32Desc, SortDescending, 1)                                         \
+  X(double, F64Asc, SortAscending, HWY_HAVE_FLOAT64)                           \
+  X(double, F64Desc, SortDescending, HWY_HAVE_FLOAT64)                         \
+  X(K32V32, KV64Asc, SortAscending, 1)                                         \
+  X(K32V32, KV64Desc, SortDescending, 1)                                       \
+  X(uint128_t, 128Asc, SortAscending, 1)                                       \
+  X(uint128_t, 128Desc, SortDescending, 1)                                     \
+  X(K64V64, KV128Asc, SortAscending, 1)                                        \
+  X(K64V64, KV128Desc, SortDescending, 1)
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+template <typename Key, class Order>
+void MergeIfEnabled(hwy::SizeTag<1> /* enabled */, const Key* HWY_RESTRICT a,
+                    const size_t num_a, const Key* HWY_RESTRICT b,
+                    const size_t num_b, Key* HWY_RESTRICT out, Order order) {
+  return VQMergeStatic(a, num_a, b, num_b, out, order);
+}
+template <typename Key, class Order>
+void MergeIfEnabled(hwy::SizeTag<0> /* enabled */, const Key* HWY_RESTRICT,
+                    size_t, const Key* HWY_RESTRICT, size_t,
+                    Key* HWY_RESTRICT, Order) {
+  HWY_ASSERT(0);
+}
+
+#define HWY_MERGE_DEFINE(KEY, NAME, ORDER, ENABLED)                            \
+  void Merge##NAME(const KEY* HWY_RESTRICT a, const size_t num_a,              \
+                   const KEY* HWY_RESTRICT b, const size_t num_b,              \
+                   KEY* HWY_RESTRICT out) {                                    \
+    return MergeIfEnabled(hwy::SizeTag<(ENABLED)>(), a, num_a, b, num_b, out,  \
+                          ORDER());                                            \
+  }
+HWY_MERGE_FOREACH_KEY(HWY_MERGE_DEFINE)
+#undef HWY_MERGE_DEFINE
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+
+#define HWY_MERGE_EXPORT(KEY, NAME, ORDER, ENABLED) HWY_EXPORT(Merge##NAME);
+HWY_MERGE_FOREACH_KEY(HWY_MERGE_EXPORT)
+#undef HWY_MERGE_EXPORT
+
+// Pairwise rounds of 2-way merges, alternating between `out` and a buffer.
+// This moves each key ceil(log2(num_runs)) times, but each pass is a
+// vectorized streaming merge.
+template <typename Key, class Order>
+void MergeRuns(const Key* const* HWY_RESTRICT runs,
+               const size_t* HWY_RESTRICT run_sizes, size_t num_runs,
+               Key* HWY_RESTRICT out, Order order) {
+  size_t total = 0;
+  for (size_t i = 0; i < num_runs; ++i) total += run_sizes[i];
+  if (total == 0) return;
+  if (num_runs == 1) return CopyBytes(runs[0], out, total * sizeof(Key));
+  if (num_runs == 2) {
+    return VQMerge(runs[0], run_sizes[0], runs[1], run_sizes[1], out, order);
+  }
+
+  AlignedFreeUniquePtr<Key[]> buf = AllocateAligned<Key>(total);
+  HWY_ASSERT(buf);
+
+  // Choose the first destination such that the last pass writes to `out`.
+  const size_t num_passes = CeilLog2(num_runs);
+  Key* dst = (num_passes & 1) ? out : buf.get();
+  Key* other = (num_passes & 1) ? buf.get() : out;
+
+  std::vector<const Key*> src(runs, runs + num_runs);
+  std::vector<size_t> sizes(run_sizes, run_sizes + num_runs);
+  while (src.size() > 1) {
+    size_t pos = 0;
+    size_t num_out = 0;
+    for (size_t i = 0; i < src.size(); i += 2) {
+      Key* begin = dst + pos;
+      size_t size = sizes[i];
+      if (i + 1 == src.size()) {
+        CopyBytes(src[i], begin, size * sizeof(Key));
+      } else {
+        VQMerge(src[i], sizes[i], src[i + 1], sizes[i + 1], begin, order);
+        size += sizes[i + 1];
+      }
+      src[num_out] = begin;
+      sizes[num_out] = size;
+      ++num_out;
+      pos += size;
+    }
+    src.resize(num_out);
+    sizes.resize(num_out);
+    Key* next = other;
+    other = dst;
+    dst = next;
+  }
+  HWY_DASSERT(src[0] == out);
+}
+
+}  // namespace
+
+#define HWY_MERGE_DISPATCH(KEY, NAME, ORDER, ENABLED)                          \
+  void VQMerge(const KEY* HWY_RESTRICT a, const size_t num_a,                  \
+               const KEY* HWY_RESTRICT b, const size_t num_b,                  \
+               KEY* HWY_RESTRICT out, ORDER) {                                 \
+    HWY_DYNAMIC_DISPATCH(Merge##NAME)(a, num_a, b, num_b, out);                \
+  }                                                                            \
+  void VQMerge(const KEY* const* HWY_RESTRICT runs,                            \
+               const size_t* HWY_RESTRICT run_sizes, const size_t num_runs,    \
+               KEY* HWY_RESTRICT out, ORDER order) {                           \
+    MergeRuns(runs, run_sizes, num_runs, out, order);                          \
+  }
+HWY_MERGE_FOREACH_KEY(HWY_MERGE_DISPATCH)
+#undef HWY_MERGE_DISPATCH
+
+}  // namespace hwy
+#endif  // HWY_ONCE
@@ -0,0 +1,279 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parallel sample sort on top of the dynamic-dispatch VQSort. Only the
+// splitter search is scalar; the per-bucket sorts use the best vector target.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+namespace hwy {
+namespace {
+
+// Below this many keys per worker, the overhead of the extra passes over
+// memory outweighs the parallel speedup.
+constexpr size_t kMinKeysPerWorker = 16 * 1024;
+// Enough buckets per worker for work stealing to even out their sizes.
+constexpr size_t kBucketsPerWorker = 8;
+// Bucket indices are stored as uint16_t.
+constexpr size_t kMaxBuckets = 4096;
+// More samples per bucket reduce the variance of bucket sizes.
+constexpr size_t kSamplesPerBucket = 32;
+// Tasks for the classify/scatter passes; more than workers to allow stealing.
+constexpr size_t kChunksPerWorker = 4;
+
+// VQSort moves NaN to the back regardless of the order, so treat them as
+// larger than all other keys for both orders. Overloads are preferred over
+// the template, which handles all non-float key types.
+template <typename Key>
+HWY_INLINE bool IsNaNKey(const Key&) {
+  return false;
+}
+HWY_INLINE bool IsNaNKey(float16_t key) { return ScalarIsNaN(key); }
+HWY_INLINE bool IsNaNKey(float key) { return ScalarIsNaN(key); }
+HWY_INLINE bool IsNaNKey(double key) { return ScalarIsNaN(key); }
+
+// Returns whether `a` is sorted before `b`. Strict weak ordering consistent
+// with that of VQSort, which only compares the key of key-value types.
+template <class Order, typename Key>
+HWY_INLINE bool KeyBefore(const Key& a, const Key& b) {
+  if (HWY_UNLIKELY(IsNaNKey(a))) return false;
+  if (HWY_UNLIKELY(IsNaNKey(b))) return true;
+  return Order::IsAscending() ? (a < b) : (b < a);
+}
+
+// Branchless upper bound: returns the number of splitters not after `key`,
+// i.e. the index of its bucket. `num_splitters` must be nonzero.
+template <class Order, typename Key>
+HWY_INLINE size_t BucketIndex(const Key& key, const Key* HWY_RESTRICT splitters,
+                              size_t num_splitters) {
+  const Key* base = splitters;
+  size_t len = num_splitters;
+  while (len > 1) {
+    const size_t half = len / 2;
+    base = KeyBefore<Order>(key, base[half]) ? base : base + half;
+    len -= half;
+  }
+  return static_cast<size_t>(base - splitters) +
+         (KeyBefore<Order>(key, *base) ? 0 : 1);
+}
+
+HWY_INLINE uint64_t SplitMix64(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+template <typename Key, class Order>
+void ParallelSort(Key* HWY_RESTRICT keys, const size_t n, Order order,
+                  ThreadPool& pool) {
+  const size_t num_workers = pool.NumWorkers();
+  if (num_workers <= 1 || n < 2 * kMinKeysPerWorker) {
+    return VQSort(keys, n, order);
+  }
+
+  const size_t num_buckets =
+      HWY_MIN(HWY_MIN(num_workers * kBucketsPerWorker, kMaxBuckets),
+              HWY_MAX(size_t{2}, n / kMinKeysPerWorker));
+  const size_t num_splitters = num_buckets - 1;
+  const size_t num_chunks = num_workers * kChunksPerWorker;
+  const size_t keys_per_chunk = DivCeil(n, num_chunks);
+
+  AlignedFreeUniquePtr<Key[]> copy = AllocateAligned<Key>(n);
+  AlignedFreeUniquePtr<uint16_t[]> bucket_of = AllocateAligned<uint16_t>(n);
+  // [chunk][bucket]: first the number of keys, later the output position.
+  AlignedFreeUniquePtr<size_t[]> positions =
+      AllocateAligned<size_t>(num_chunks * num_buckets);
+  const size_t num_samples = num_buckets * kSamplesPerBucket;
+  AlignedFreeUniquePtr<Key[]> samples = AllocateAligned<Key>(num_samples);
+  if (HWY_UNLIKELY(!copy || !bucket_of || !positions || !samples)) {
+    return VQSort(keys, n, order);
+  }
+
+  // Choose splitters as evenly spaced ranks of a sorted random sample.
+  uint64_t seed[2] = {0x9E3779B97F4A7C15ull, n};
+  (void)Fill16BytesSecure(seed);
+  uint64_t state = seed[0] ^ seed[1];
+  for (size_t i = 0; i < num_samples; ++i) {
+    state = SplitMix64(state);
+    // Modulo bias is negligible because n is much less than 2^64.
+    samples[i] = keys[state % n];
+  }
+  VQSort(samples.get(), num_samples, order);
+  Key* HWY_RESTRICT splitters = samples.get();
+  for (size_t b = 0; b < num_splitters; ++b) {
+    splitters[b] = samples[(b + 1) * kSamplesPerBucket];
+  }
+
+  // Classify: count keys per bucket within each chunk, and remember the bucket
+  // so that the scatter pass does not repeat the search.
+  ZeroBytes(positions.get(), num_chunks * num_buckets * sizeof(size_t));
+  pool.Run(0, num_chunks, [&](uint64_t chunk, size_t /*thread*/) {
+    const size_t begin = HWY_MIN(n, static_cast<size_t>(chunk) * keys_per_chunk);
+    const size_t end = HWY_MIN(n, begin + keys_per_chunk);
+    size_t* HWY_RESTRICT counts = positions.get() + chunk * num_buckets;
+    for (size_t i = begin; i < end; ++i) {
+      const size_t b = BucketIndex<Order>(keys[i], splitters, num_splitters);
+      bucket_of[i] = static_cast<uint16_t>(b);
+      ++counts[b];
+    }
+  });
+
+  // Exclusive prefix sum in bucket-major order, so that each bucket is
+  // contiguous and chunks write their keys in ascending order within it.
+  std::vector<size_t> bucket_begin(num_buckets + 1);
+  size_t total = 0;
+  for (size_t b = 0; b < num_buckets; ++b) {
+    bucket_begin[b] = total;
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      size_t& pos = positions[chunk * num_buckets + b];
+      const size_t count = pos;
+      pos = total;
+      total += count;
+    }
+  }
+  bucket_begin[num_buckets] = total;
+  HWY_DASSERT(total == n);
+
+  // Scatter: each chunk owns disjoint output ranges, so no atomics required.
+  pool.Run(0, num_chunks, [&](uint64_t chunk, size_t /*thread*/) {
+    const size_t begin = HWY_MIN(n, static_cast<size_t>(chunk) * keys_per_chunk);
+    const size_t end = HWY_MIN(n, begin + keys_per_chunk);
+    size_t* HWY_RESTRICT pos = positions.get() + chunk * num_buckets;
+    for (size_t i = begin; i < end; ++i) {
+      copy[pos[bucket_of[i]]++] = keys[i];
+    }
+  });
+
+  // Sort each bucket while it is still in cache, then copy it back.
+  pool.Run(0, num_buckets, [&](uint64_t b, size_t /*thread*/) {
+    const size_t begin = bucket_begin[b];
+    const size_t num = bucket_begin[b + 1] - begin;
+    VQSort(copy.get() + begin, num, order);
+    CopyBytes(copy.get() + begin, keys + begin, num * sizeof(Key));
+  });
+}
+
+}  // namespace
+
+void VQSort(uint16_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(uint16_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(uint32_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(uint32_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(uint64_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(uint64_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+
+void VQSort(int16_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(int16_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(int32_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(int32_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(int64_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(int64_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+
+void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(float* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(float* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(double* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(double* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+
+void VQSort(K32V32* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(K32V32* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+
+void VQSort(uint128_t* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(uint128_t* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(K64V64* HWY_RESTRICT keys, size_t n, SortAscending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+void VQSort(K64V64* HWY_RESTRICT keys, size_t n, SortDescending tag,
+            ThreadPool& pool) {
+  ParallelSort(keys, n, tag, pool);
+}
+
+}  // namespace hwy
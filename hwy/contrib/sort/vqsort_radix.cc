@@ -0,0 +1,89 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/contrib/sort/vqsort.h"  // VQRadixSort
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_radix.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqsort-inl.h"
+
+// NAME is the suffix of the per-target function, and ENABLED whether the
+// target supports the key type.
+#define HWY_RADIX_FOREACH_KEY(X)                                               \
+  X(uint16_t, U16Asc, SortAscending, 1)                                        \
+  X(uint16_t, U16Desc, SortDescending, 1)                                      \
+  X(uint32_t, U32Asc, SortAscending, 1)                                        \
+  X(uint32_t, U32Desc, SortDescending, 1)                                      \
+  X(int16_t, I16Asc, SortAscending, 1)                                         \
+  X(int16_t, I16Desc, SortDescending, 1)                                       \
+  X(int32_t, I32Asc, SortAscending, 1)                                         \
+  X(int32_t, I32Desc, SortDescending, 1)                                       \
+  X(float16_t, F16Asc, SortAscending, HWY_HAVE_FLOAT16)                        \
+  X(float16_t, F16Desc, SortDescending, HWY_HAVE_FLOAT16)                      \
+  X(float, F32Asc, SortAscending, 1)                                           \
+  X(float, F32Desc, SortDescending, 1)
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+template <typename Key, class Order>
+void RadixSortIfEnabled(hwy::SizeTag<1> /* enabled */, Key* HWY_RESTRICT keys,
+                        const size_t num, Order order) {
+  VQRadixSortStatic(keys, num, order);
+}
+template <typename Key, class Order>
+void RadixSortIfEnabled(hwy::SizeTag<0> /* enabled */, Key* HWY_RESTRICT,
+                        size_t, Order) {
+  HWY_ASSERT(0);
+}
+
+#define HWY_RADIX_DEFINE(KEY, NAME, ORDER, ENABLED)                            \
+  void RadixSort##NAME(KEY* HWY_RESTRICT keys, const size_t num) {             \
+    return RadixSortIfEnabled(hwy::SizeTag<(ENABLED)>(), keys, num, ORDER());  \
+  }
+HWY_RADIX_FOREACH_KEY(HWY_RADIX_DEFINE)
+#undef HWY_RADIX_DEFINE
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+
+#define HWY_RADIX_EXPORT(KEY, NAME, ORDER, ENABLED) HWY_EXPORT(RadixSort##NAME);
+HWY_RADIX_FOREACH_KEY(HWY_RADIX_EXPORT)
+#undef HWY_RADIX_EXPORT
+
+}  // namespace
+
+#define HWY_RADIX_DISPATCH(KEY, NAME, ORDER, ENABLED)                          \
+  void VQRadixSort(KEY* HWY_RESTRICT keys, const size_t n, ORDER) {            \
+    HWY_DYNAMIC_DISPATCH(RadixSort##NAME)(keys, n);                            \
+  }
+HWY_RADIX_FOREACH_KEY(HWY_RADIX_DISPATCH)
+#undef HWY_RADIX_DISPATCH
+
+}  // namespace hwy
+#endif  // HWY_ONCE
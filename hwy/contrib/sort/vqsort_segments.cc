@@ -0,0 +1,176 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>  // std::lower_bound
+
+#include "hwy/contrib/sort/vqsort.h"  // VQSortSegments
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_segments.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqsort-inl.h"
+
+// Only the sorting networks are instantiated here; segments too large for them
+// are passed to the dynamic-dispatch VQSort, which avoids compiling another
+// copy of the quicksort for every key type. NAME is the suffix of the
+// per-target function, and ENABLED whether the target supports the key type.
+#define HWY_SEGMENTS_FOREACH_KEY(X)                                            \
+  X(uint16_t, U16Asc, SortAscending, 1)                                        \
+  X(uint16_t, U16Desc, SortDescending, 1)                                      \
+  X(uint32_t, U32Asc, SortAscending, 1)                                        \
+  X(uint32_t, U32Desc, SortDescending, 1)                                      \
+  X(uint64_t, U64Asc, SortAscending, 1)                                        \
+  X(uint64_t, U64Desc, SortDescending, 1)                                      \
+  X(int16_t, I16Asc, SortAscending, 1)                                         \
+  X(int16_t, I16Desc, SortDescending, 1)                                       \
+  X(int32_t, I32Asc, SortAscending, 1)                                         \
+  X(int32_t, I32Desc, SortDescending, 1)                                       \
+  X(int64_t, I64Asc, SortAscending, 1)                                         \
+  X(int64_t, I64Desc, SortDescending, 1)                                       \
+  X(float16_t, F16Asc, SortAscending, HWY_HAVE_FLOAT16)                        \
+  X(float16_t, F16Desc, SortDescending, HWY_HAVE_FLOAT16)                      \
+  X(float, F32Asc, SortAscending, 1)                                           \
+  X(float, F32Desc, SortDescending, 1)                                         \
+  X(double, F64Asc, SortAscending, HWY_HAVE_FLOAT64)                           \
+  X(double, F64Desc, SortDescending, HWY_HAVE_FLOAT64)                         \
+  X(K32V32, KV64Asc, SortAscending, 1)                                         \
+  X(K32V32, KV64Desc, SortDescending, 1)                                       \
+  X(uint128_t, 128Asc, SortAscending, 1)                                       \
+  X(uint128_t, 128Desc, SortDescending, 1)                                     \
+  X(K64V64, KV128Asc, SortAscending, 1)                                        \
+  X(K64V64, KV128Desc, SortDescending, 1)
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+template <typename Key, class Order>
+void SortSegmentsIfEnabled(hwy::SizeTag<1> /* enabled */,
+                           Key* HWY_RESTRICT keys,
+                           const size_t* HWY_RESTRICT offsets,
+                           const size_t num_segments, Order order) {
+#if VQSORT_ENABLED
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  constexpr size_t kLPK = st.LanesPerKey();
+  HWY_ALIGN LaneType buf[SortConstants::BufBytes<LaneType, kLPK>(
+                             HWY_MAX_BYTES) /
+                         sizeof(LaneType)];
+  SortSegments(d, st, reinterpret_cast<LaneType*>(keys), offsets, num_segments,
+               buf, [order](LaneType* HWY_RESTRICT segment, size_t num) {
+                 VQSort(reinterpret_cast<Key*>(segment), num / kLPK, order);
+               });
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  (void)order;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+template <typename Key, class Order>
+void SortSegmentsIfEnabled(hwy::SizeTag<0> /* enabled */, Key* HWY_RESTRICT,
+                           const size_t* HWY_RESTRICT, size_t, Order) {
+  HWY_ASSERT(0);
+}
+
+#define HWY_SEGMENTS_DEFINE(KEY, NAME, ORDER, ENABLED)                         \
+  void SortSegments##NAME(KEY* HWY_RESTRICT keys,                              \
+                          const size_t* HWY_RESTRICT offsets,                  \
+                          const size_t num_segments) {                         \
+    return SortSegmentsIfEnabled(hwy::SizeTag<(ENABLED)>(), keys, offsets,     \
+                                 num_segments, ORDER());                       \
+  }
+HWY_SEGMENTS_FOREACH_KEY(HWY_SEGMENTS_DEFINE)
+#undef HWY_SEGMENTS_DEFINE
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+
+#define HWY_SEGMENTS_EXPORT(KEY, NAME, ORDER, ENABLED) \
+  HWY_EXPORT(SortSegments##NAME);
+HWY_SEGMENTS_FOREACH_KEY(HWY_SEGMENTS_EXPORT)
+#undef HWY_SEGMENTS_EXPORT
+
+// Tasks per worker; more than one allows work stealing to balance the load.
+constexpr size_t kTasksPerWorker = 8;
+// Below this many keys per task, the parallel overhead outweighs the speedup.
+constexpr size_t kMinKeysPerTask = 4096;
+
+// Calls `sort(offsets + first, num)` for consecutive ranges of segments with
+// about the same number of keys, in parallel.
+template <class Func>
+void ParallelSegments(const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                      ThreadPool& pool, const Func& sort) {
+  if (num_segments == 0) return;
+  const size_t num_keys = offsets[num_segments] - offsets[0];
+  const size_t num_tasks =
+      HWY_MIN(HWY_MIN(pool.NumWorkers() * kTasksPerWorker, num_segments),
+              num_keys / kMinKeysPerTask);
+  if (pool.NumWorkers() <= 1 || num_tasks <= 1) {
+    return sort(offsets, num_segments);
+  }
+
+  // Splits at the first segment that begins at or after the task's share of
+  // the keys. Tasks may be empty if a single segment is large.
+  const auto first_segment = [&](uint64_t task) -> size_t {
+    if (task == num_tasks) return num_segments;
+    const size_t begin_key =
+        offsets[0] + static_cast<size_t>(task) * num_keys / num_tasks;
+    return static_cast<size_t>(
+        std::lower_bound(offsets, offsets + num_segments, begin_key) - offsets);
+  };
+  pool.Run(0, num_tasks, [&](uint64_t task, size_t /*thread*/) {
+    const size_t first = first_segment(task);
+    const size_t end = first_segment(task + 1);
+    if (first != end) sort(offsets + first, end - first);
+  });
+}
+
+}  // namespace
+
+#define HWY_SEGMENTS_DISPATCH(KEY, NAME, ORDER, ENABLED)                       \
+  void VQSortSegments(KEY* HWY_RESTRICT keys,                                  \
+                      const size_t* HWY_RESTRICT offsets,                      \
+                      const size_t num_segments, ORDER) {                      \
+    HWY_DYNAMIC_DISPATCH(SortSegments##NAME)(keys, offsets, num_segments);     \
+  }                                                                            \
+  void VQSortSegments(KEY* HWY_RESTRICT keys,                                  \
+                      const size_t* HWY_RESTRICT offsets,                      \
+                      const size_t num_segments, ORDER, ThreadPool& pool) {    \
+    ParallelSegments(offsets, num_segments, pool,                              \
+                     [keys](const size_t* HWY_RESTRICT first, size_t num) {    \
+                       HWY_DYNAMIC_DISPATCH(SortSegments##NAME)(keys, first,   \
+                                                                num);          \
+                     });                                                       \
+  }
+HWY_SEGMENTS_FOREACH_KEY(HWY_SEGMENTS_DISPATCH)
+#undef HWY_SEGMENTS_DISPATCH
+
+}  // namespace hwy
+#endif  // HWY_ONCE